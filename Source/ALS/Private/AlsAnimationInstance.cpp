@@ -7,6 +7,10 @@
 #include "Curves/CurveFloat.h"
 #include "Engine/SkeletalMesh.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/HUD.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/OutputDevice.h"
 #include "Settings/AlsAnimationInstanceSettings.h"
 #include "Settings/AlsCharacterSettings.h"
 #include "Utility/AlsConstants.h"
@@ -14,6 +18,7 @@
 #include "Utility/AlsMacros.h"
 #include "Utility/AlsPrivateMemberAccessor.h"
 #include "Utility/AlsRotation.h"
+#include "Utility/AlsTrace.h"
 #include "Utility/AlsUtility.h"
 #include "Utility/AlsVector.h"
 
@@ -22,6 +27,42 @@
 ALS_DEFINE_PRIVATE_MEMBER_ACCESSOR(AlsGetAnimationCurvesAccessor, &FAnimInstanceProxy::GetAnimationCurves,
                                    const TMap<FName, float>& (FAnimInstanceProxy::*)(EAnimCurveType) const)
 
+#if WITH_EDITORONLY_DATA && ALLOW_CONSOLE
+namespace AlsAnimationInstance
+{
+	void DumpDebugTraces(const TArray<FString>& Arguments, UWorld* World, FOutputDevice& Output)
+	{
+		// Use the debug target of the HUD, or the possessed character if the HUD has no debug target.
+
+		const auto* Player{IsValid(World) ? World->GetFirstPlayerController() : nullptr};
+		const auto* Hud{IsValid(Player) ? Player->GetHUD() : nullptr};
+
+		const auto* Character{IsValid(Hud) ? Cast<AAlsCharacter>(Hud->GetCurrentDebugTargetActor()) : nullptr};
+		if (!IsValid(Character) && IsValid(Player))
+		{
+			Character = Cast<AAlsCharacter>(Player->GetPawn());
+		}
+
+		const auto* AnimationInstance{IsValid(Character) ? Cast<UAlsAnimationInstance>(Character->GetMesh()->GetAnimInstance()) : nullptr};
+		if (!IsValid(AnimationInstance))
+		{
+			Output.Log(TEXT("No ALS character is selected, select one with the ShowDebug command or possess one."));
+			return;
+		}
+
+		Output.Logf(TEXT("%s:"), *Character->GetName());
+		AnimationInstance->DumpDisplayDebugTraces(Output);
+	}
+
+	FAutoConsoleCommandWithWorldArgsAndOutputDevice ConsoleCommandDumpTraces{
+		TEXT("Als.Debug.DumpTraces"),
+		TEXT("Writes the last debug traces of the selected ALS character to the console. ")
+		TEXT("Traces are only recorded while the ALS.Traces debug display is enabled."),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&DumpDebugTraces)
+	};
+}
+#endif
+
 void UAlsAnimationInstance::NativeInitializeAnimation()
 {
 	Super::NativeInitializeAnimation();
@@ -86,7 +127,14 @@ void UAlsAnimationInstance::NativeBeginPlay()
 {
 	Super::NativeBeginPlay();
 
-	ALS_ENSURE(IsValid(Settings));
+	if (ALS_ENSURE(IsValid(Settings)))
+	{
+		// Dynamic montages are usually built when the settings are loaded, but that
+		// can't be done when the settings are loaded outside of the game thread.
+
+		Settings->PrebuildDynamicMontages();
+	}
+
 	ALS_ENSURE(IsValid(Character));
 }
 
@@ -103,6 +151,8 @@ void UAlsAnimationInstance::NativeUpdateAnimation(const float DeltaTime)
 		return;
 	}
 
+	const FAlsCostScope CostScope{&Character->GetCosts(), EAlsCostCategory::AnimationGameThread};
+
 	auto* Mesh{GetSkelMeshComponent()};
 
 	if (Mesh->IsUsingAbsoluteRotation() && IsValid(Mesh->GetAttachParent()))
@@ -168,6 +218,8 @@ void UAlsAnimationInstance::NativeThreadSafeUpdateAnimation(const float DeltaTim
 		return;
 	}
 
+	const FAlsCostScope CostScope{&Character->GetCosts(), EAlsCostCategory::AnimationWorkerThread};
+
 	DynamicTransitionsState.bUpdatedThisFrame = false;
 	RotateInPlaceState.bUpdatedThisFrame = false;
 	TurnInPlaceState.bUpdatedThisFrame = false;
@@ -200,13 +252,12 @@ void UAlsAnimationInstance::NativePostUpdateAnimation()
 #if WITH_EDITORONLY_DATA && ENABLE_DRAW_DEBUG
 	if (!bPendingUpdate)
 	{
-		for (const auto& DisplayDebugTraceFunction : DisplayDebugTracesQueue)
-		{
-			DisplayDebugTraceFunction();
-		}
+		DisplayDebugTracesBuffer.Drain(GetWorld());
+	}
+	else
+	{
+		DisplayDebugTracesBuffer.Reset();
 	}
-
-	DisplayDebugTracesQueue.Reset();
 #endif
 
 	bPendingUpdate = false;
@@ -1036,6 +1087,20 @@ void UAlsAnimationInstance::RefreshGroundPrediction()
 	if (InAirState.VerticalVelocity > VerticalVelocityThreshold)
 	{
 		InAirState.GroundPredictionAmount = 0.0f;
+
+		if (GroundPredictionSweepHandle.IsValid() || GroundPredictionSweepHit.bBlockingHit)
+		{
+			auto* SceneQuerySubsystem{UAlsSceneQuerySubsystem::Get(GetWorld())};
+			if (IsValid(SceneQuerySubsystem))
+			{
+				SceneQuerySubsystem->Cancel(GroundPredictionSweepHandle);
+			}
+
+			GroundPredictionSweepHandle.Invalidate();
+			GroundPredictionSweepHit = FHitResult{};
+			GroundPredictionSweepHitReusesCount = 0;
+		}
+
 		return;
 	}
 
@@ -1064,11 +1129,56 @@ void UAlsAnimationInstance::RefreshGroundPrediction()
 		                                                      InAirState.VerticalVelocity) * LocomotionState.Scale
 	};
 
+	const auto SweepShape{FCollisionShape::MakeCapsule(LocomotionState.CapsuleRadius, LocomotionState.CapsuleHalfHeight)};
+	const FCollisionQueryParams QueryParams{__FUNCTION__, false, Character};
+
+	auto* SceneQuerySubsystem{Settings->InAir.bDeferGroundPredictionSweep ? UAlsSceneQuerySubsystem::Get(GetWorld()) : nullptr};
+
+	// The time of a reused result is measured from the location at which it was traced, so
+	// it goes stale quickly while falling. Trace again after a few frames regardless of the budget.
+
+	static constexpr auto MaxGroundPredictionSweepHitReusesCount{3};
+
 	FHitResult Hit;
-	GetWorld()->SweepSingleByChannel(Hit, SweepStartLocation, SweepStartLocation + SweepVector,
-	                                 FQuat::Identity, Settings->InAir.GroundPredictionSweepChannel,
-	                                 FCollisionShape::MakeCapsule(LocomotionState.CapsuleRadius, LocomotionState.CapsuleHalfHeight),
-	                                 {__FUNCTION__, false, Character}, Settings->InAir.GroundPredictionSweepResponses);
+
+	if (IsValid(SceneQuerySubsystem))
+	{
+		// Use the result of the last completed sweep and request a new one once it is no longer pending.
+
+		if (SceneQuerySubsystem->RetrieveResult(GroundPredictionSweepHandle, GroundPredictionSweepHit) != EAlsSceneQueryStatus::Pending)
+		{
+			GroundPredictionSweepHandle = SceneQuerySubsystem->RequestSweep(EAlsSceneQuerySource::GroundPrediction, SweepStartLocation,
+			                                                                SweepStartLocation + SweepVector, FQuat::Identity,
+			                                                                Settings->InAir.GroundPredictionSweepChannel, SweepShape,
+			                                                                QueryParams, Settings->InAir.GroundPredictionSweepResponses);
+
+			CSV_CUSTOM_STAT(Als, GroundPredictionQueries, 1, ECsvCustomStatOp::Accumulate);
+		}
+
+		Hit = GroundPredictionSweepHit;
+	}
+	else if (GroundPredictionSweepHit.bBlockingHit && GroundPredictionSweepHitReusesCount < MaxGroundPredictionSweepHitReusesCount &&
+	         UAlsSceneQuerySubsystem::IsBudgetExceeded(GetWorld(), EAlsSceneQuerySource::GroundPrediction))
+	{
+		// The scene query budget is exceeded, so reuse the last ground prediction result for a few frames.
+
+		Hit = GroundPredictionSweepHit;
+		GroundPredictionSweepHitReusesCount += 1;
+
+		CSV_CUSTOM_STAT(Als, DegradedQueries, 1, ECsvCustomStatOp::Accumulate);
+	}
+	else
+	{
+		UAlsSceneQuerySubsystem::SweepSingleByChannel(GetWorld(), EAlsSceneQuerySource::GroundPrediction, Hit,
+		                                              SweepStartLocation, SweepStartLocation + SweepVector, FQuat::Identity,
+		                                              Settings->InAir.GroundPredictionSweepChannel, SweepShape, QueryParams,
+		                                              Settings->InAir.GroundPredictionSweepResponses);
+
+		GroundPredictionSweepHit = Hit;
+		GroundPredictionSweepHitReusesCount = 0;
+
+		CSV_CUSTOM_STAT(Als, GroundPredictionQueries, 1, ECsvCustomStatOp::Accumulate);
+	}
 
 	const auto bGroundValid{Hit.IsValidBlockingHit() && Hit.ImpactNormal.Z >= LocomotionState.WalkableFloorAngleCos};
 
@@ -1083,13 +1193,20 @@ void UAlsAnimationInstance::RefreshGroundPrediction()
 		}
 		else
 		{
-			DisplayDebugTracesQueue.Emplace([this, Hit, bGroundValid]
-				{
-					UAlsDebugUtility::DrawSweepSingleCapsule(GetWorld(), Hit.TraceStart, Hit.TraceEnd, FRotator::ZeroRotator,
-					                                         LocomotionState.CapsuleRadius, LocomotionState.CapsuleHalfHeight,
-					                                         bGroundValid, Hit, {0.25f, 0.0f, 1.0f}, {0.75f, 0.0f, 1.0f});
-				}
-			);
+			FAlsDebugShape Shape;
+			Shape.Type = EAlsDebugShapeType::SweepCapsule;
+			Shape.Start = Hit.TraceStart;
+			Shape.End = Hit.TraceEnd;
+			Shape.HitLocation = Hit.Location;
+			Shape.HitImpactPoint = Hit.ImpactPoint;
+			Shape.Rotation = FRotator::ZeroRotator;
+			Shape.TraceColor = {0.25f, 0.0f, 1.0f};
+			Shape.HitColor = {0.75f, 0.0f, 1.0f};
+			Shape.Radius = LocomotionState.CapsuleRadius;
+			Shape.HalfHeight = LocomotionState.CapsuleHalfHeight;
+			Shape.bHit = bGroundValid && Hit.bBlockingHit;
+
+			DisplayDebugTracesBuffer.Record(Shape);
 		}
 	}
 #endif
@@ -1261,6 +1378,8 @@ void UAlsAnimationInstance::RefreshFootLock(const float IkAmount, FAlsFootState&
 	{
 		if (FootState.LockAmount > 0.0f)
 		{
+			ALS_TRACE_STATE_CHANGED(Character, EAlsTraceEventType::FootLockReleased, LockCurveName);
+
 			FootState.LockAmount = 0.0f;
 
 			FootState.LockLocation = FVector::ZeroVector;
@@ -1288,6 +1407,8 @@ void UAlsAnimationInstance::RefreshFootLock(const float IkAmount, FAlsFootState&
 	{
 		if (bNewAmountGreaterThanPrevious)
 		{
+			ALS_TRACE_STATE_CHANGED(Character, EAlsTraceEventType::FootLockEngaged, LockCurveName);
+
 			// If the new foot lock amount is 1 and the previous amount is less than 1, then save the new foot lock location and rotation.
 
 			if (FootState.LockAmount <= 0.9f)
@@ -1590,14 +1711,21 @@ void UAlsAnimationInstance::PlayQueuedTransitionAnimation()
 {
 	check(IsInGameThread())
 
-	if (TransitionsState.bStopTransitionsQueued || !IsValid(TransitionsState.QueuedTransitionSequence))
+	if (TransitionsState.bStopTransitionsQueued || !IsValid(TransitionsState.QueuedTransitionSequence) || !IsValid(Settings))
 	{
 		return;
 	}
 
-	PlaySlotAnimationAsDynamicMontage(TransitionsState.QueuedTransitionSequence, UAlsConstants::TransitionSlotName(),
-	                                  TransitionsState.QueuedTransitionBlendInDuration, TransitionsState.QueuedTransitionBlendOutDuration,
-	                                  TransitionsState.QueuedTransitionPlayRate, 1, 0.0f, TransitionsState.QueuedTransitionStartTime);
+	auto* Montage{
+		Settings->DynamicMontages.FindOrCreate(TransitionsState.QueuedTransitionSequence, UAlsConstants::TransitionSlotName(),
+		                                       TransitionsState.QueuedTransitionBlendInDuration,
+		                                       TransitionsState.QueuedTransitionBlendOutDuration)
+	};
+
+	Montage_Play(Montage, TransitionsState.QueuedTransitionPlayRate,
+	             EMontagePlayReturnType::MontageLength, TransitionsState.QueuedTransitionStartTime);
+
+	ALS_TRACE_STATE_CHANGED(Character, EAlsTraceEventType::Transition, GetFNameSafe(TransitionsState.QueuedTransitionSequence));
 
 	TransitionsState.QueuedTransitionSequence = nullptr;
 	TransitionsState.QueuedTransitionBlendInDuration = 0.0f;
@@ -1816,9 +1944,14 @@ void UAlsAnimationInstance::PlayQueuedTurnInPlaceAnimation()
 
 	const auto* TurnInPlaceSettings{TurnInPlaceState.QueuedSettings.Get()};
 
-	PlaySlotAnimationAsDynamicMontage(TurnInPlaceSettings->Sequence, TurnInPlaceState.QueuedSlotName,
-	                                  Settings->TurnInPlace.BlendDuration, Settings->TurnInPlace.BlendDuration,
-	                                  TurnInPlaceSettings->PlayRate, 1, 0.0f);
+	auto* Montage{
+		Settings->DynamicMontages.FindOrCreate(TurnInPlaceSettings->Sequence, TurnInPlaceState.QueuedSlotName,
+		                                       Settings->TurnInPlace.BlendDuration, Settings->TurnInPlace.BlendDuration)
+	};
+
+	Montage_Play(Montage, TurnInPlaceSettings->PlayRate);
+
+	ALS_TRACE_STATE_CHANGED(Character, EAlsTraceEventType::TurnInPlace, GetFNameSafe(TurnInPlaceSettings->Sequence));
 
 	// Scale the rotation yaw delta (gets scaled in animation graph) to compensate for play rate and turn angle (if allowed).
 
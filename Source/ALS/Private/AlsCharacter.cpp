@@ -2,6 +2,7 @@
 
 #include "AlsAnimationInstance.h"
 #include "AlsCharacterMovementComponent.h"
+#include "AlsCharacterTickSubsystem.h"
 #include "TimerManager.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/SkeletalMeshComponent.h"
@@ -14,6 +15,7 @@
 #include "Utility/AlsConstants.h"
 #include "Utility/AlsMacros.h"
 #include "Utility/AlsRotation.h"
+#include "Utility/AlsTrace.h"
 #include "Utility/AlsUtility.h"
 #include "Utility/AlsVector.h"
 
@@ -22,6 +24,8 @@
 namespace AlsCharacterConstants
 {
 	constexpr auto MinAimingYawAngleLimit{70.0f};
+
+	constexpr auto HasSpeedThreshold{FAlsCrowdStorage::HasSpeedThreshold};
 }
 
 AAlsCharacter::AAlsCharacter(const FObjectInitializer& ObjectInitializer) : Super{
@@ -188,6 +192,25 @@ void AAlsCharacter::BeginPlay()
 	AlsCharacterMovement->SetRotationMode(RotationMode);
 
 	OnOverlayModeChanged(OverlayMode);
+
+	if (UAlsCharacterTickSubsystem::IsEnabled())
+	{
+		auto* NewTickSubsystem{UAlsCharacterTickSubsystem::Get(GetWorld())};
+		if (IsValid(NewTickSubsystem))
+		{
+			NewTickSubsystem->RegisterCharacter(this);
+		}
+	}
+}
+
+void AAlsCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (TickSubsystem.IsValid())
+	{
+		TickSubsystem->UnregisterCharacter(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AAlsCharacter::CalcCamera(const float DeltaTime, FMinimalViewInfo& ViewInfo)
@@ -284,30 +307,73 @@ void AAlsCharacter::Tick(const float DeltaTime)
 		return;
 	}
 
+	CSV_CUSTOM_STAT(Als, CharactersTicked, 1, ECsvCustomStatOp::Accumulate);
+
+	if (LocomotionMode == AlsLocomotionModeTags::InAir)
+	{
+		CSV_CUSTOM_STAT(Als, CharactersInAir, 1, ECsvCustomStatOp::Accumulate);
+	}
+
+	Costs.Refresh();
+
+	const FAlsCostScope TickCostScope{&Costs, EAlsCostCategory::CharacterTick};
+
 	RefreshMovementBase();
 
 	RefreshMeshProperties();
 
-	RefreshInput(DeltaTime);
+	SmoothingTimeStep.Advance(DeltaTime, Settings->SmoothingTimeStep.bEnabled ? Settings->SmoothingTimeStep.TimeStep : 0.0f,
+	                          Settings->SmoothingTimeStep.MaxSubstepsCount);
 
-	RefreshLocomotionEarly();
+	{
+		const FAlsCostScope CostScope{&Costs, EAlsCostCategory::Locomotion};
 
-	RefreshView(DeltaTime);
-	RefreshLocomotion();
-	RefreshGait();
-	RefreshRotationMode();
+		RefreshInput(DeltaTime);
 
-	RefreshGroundedRotation(DeltaTime);
-	RefreshInAirRotation(DeltaTime);
+		RefreshLocomotionEarly();
+	}
+
+	{
+		const FAlsCostScope CostScope{&Costs, EAlsCostCategory::View};
+
+		RefreshView(DeltaTime);
+	}
+
+	{
+		const FAlsCostScope CostScope{&Costs, EAlsCostCategory::Locomotion};
+
+		RefreshLocomotion();
+		RefreshGait();
+		RefreshRotationMode();
+	}
+
+	{
+		const FAlsCostScope CostScope{&Costs, EAlsCostCategory::Rotation};
+
+		RefreshGroundedRotation(DeltaTime);
+		RefreshInAirRotation(DeltaTime);
+	}
+
+	{
+		const FAlsCostScope CostScope{&Costs, EAlsCostCategory::Mantling};
+
+		StartMantlingInAir();
+		RefreshMantling();
+	}
+
+	{
+		const FAlsCostScope CostScope{&Costs, EAlsCostCategory::Ragdolling};
+
+		RefreshRagdolling(DeltaTime);
+	}
 
-	StartMantlingInAir();
-	RefreshMantling();
-	RefreshRagdolling(DeltaTime);
 	RefreshRolling(DeltaTime);
 
 	Super::Tick(DeltaTime);
 
 	RefreshLocomotionLate();
+
+	RefreshNetUpdateFrequency();
 }
 
 void AAlsCharacter::PossessedBy(AController* NewController)
@@ -334,6 +400,17 @@ bool AAlsCharacter::OnCalculateCamera_Implementation(float DeltaTime, FMinimalVi
 	return false;
 }
 
+const FAlsCrowdStorage* AAlsCharacter::GetPreparedCrowdStorage() const
+{
+	if (CrowdIndex == INDEX_NONE || !TickSubsystem.IsValid())
+	{
+		return nullptr;
+	}
+
+	const auto& CrowdStorage{TickSubsystem->GetCrowdStorage()};
+	return CrowdStorage.IsUpToDate(CrowdIndex) ? &CrowdStorage : nullptr;
+}
+
 void AAlsCharacter::RefreshMeshProperties() const
 {
 	const auto bStandalone{IsNetMode(NM_Standalone)};
@@ -437,11 +514,89 @@ void AAlsCharacter::RefreshMovementBase()
 		                             : FRotator::ZeroRotator;
 }
 
+void AAlsCharacter::RefreshNetUpdateFrequency()
+{
+	const auto& NetUpdateSettings{Settings->NetUpdate};
+
+	if (!NetUpdateSettings.bEnableAdaptiveNetUpdateFrequency || GetLocalRole() < ROLE_Authority || IsNetMode(NM_Standalone))
+	{
+		return;
+	}
+
+	float NewNetUpdateFrequency;
+	float NewNetPriority;
+
+	if (LocomotionAction == AlsLocomotionActionTags::Ragdolling)
+	{
+		// The ragdolling action lasts until the character gets up, so use the action rate only while
+		// the ragdoll is still moving, and fall back to the idle rate once it has settled down.
+
+		if (RagdollingState.Velocity.SizeSquared() > FMath::Square(Settings->MovingSpeedThreshold))
+		{
+			NewNetUpdateFrequency = NetUpdateSettings.ActionNetUpdateFrequency;
+			NewNetPriority = NetUpdateSettings.ActionNetPriority;
+		}
+		else
+		{
+			NewNetUpdateFrequency = NetUpdateSettings.IdleNetUpdateFrequency;
+			NewNetPriority = NetUpdateSettings.IdleNetPriority;
+		}
+	}
+	else if (LocomotionAction.IsValid())
+	{
+		NewNetUpdateFrequency = NetUpdateSettings.ActionNetUpdateFrequency;
+		NewNetPriority = NetUpdateSettings.ActionNetPriority;
+	}
+	else if (LocomotionState.bMoving || LocomotionState.bHasInput || LocomotionMode != AlsLocomotionModeTags::Grounded)
+	{
+		NewNetUpdateFrequency = NetUpdateSettings.MovingNetUpdateFrequency;
+		NewNetPriority = NetUpdateSettings.MovingNetPriority;
+	}
+	else
+	{
+		NewNetUpdateFrequency = NetUpdateSettings.IdleNetUpdateFrequency;
+		NewNetPriority = NetUpdateSettings.IdleNetPriority;
+	}
+
+	NetPriority = NewNetPriority;
+
+	const auto PreviousNetUpdateFrequency{GetNetUpdateFrequency()};
+
+	if (FMath::IsNearlyEqual(PreviousNetUpdateFrequency, NewNetUpdateFrequency))
+	{
+		return;
+	}
+
+	SetNetUpdateFrequency(NewNetUpdateFrequency);
+
+	if (NewNetUpdateFrequency > PreviousNetUpdateFrequency)
+	{
+		// The next update may have been scheduled with the previous lower frequency, so don't wait for it.
+
+		ForceNetUpdate();
+	}
+}
+
 void AAlsCharacter::SetViewMode(const FGameplayTag& NewViewMode)
 {
 	SetViewMode(NewViewMode, true);
 }
 
+bool AAlsCharacter::IsDesiredStateRpcRequired() const
+{
+	// On the server, a desired state change only needs to be sent to the owning client if there is a remote one. For AI and
+	// for characters controlled by the listen server, the replicated properties are enough, so the RPCs are skipped entirely.
+
+	if (GetLocalRole() >= ROLE_Authority && GetRemoteRole() != ROLE_AutonomousProxy)
+	{
+		CSV_CUSTOM_STAT(Als, DesiredStateRpcsSkipped, 1, ECsvCustomStatOp::Accumulate);
+		return false;
+	}
+
+	CSV_CUSTOM_STAT(Als, DesiredStateRpcsSent, 1, ECsvCustomStatOp::Accumulate);
+	return true;
+}
+
 void AAlsCharacter::SetViewMode(const FGameplayTag& NewViewMode, const bool bSendRpc)
 {
 	if (ViewMode == NewViewMode || GetLocalRole() < ROLE_AutonomousProxy)
@@ -453,7 +608,7 @@ void AAlsCharacter::SetViewMode(const FGameplayTag& NewViewMode, const bool bSen
 
 	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, ViewMode, this)
 
-	if (bSendRpc)
+	if (bSendRpc && IsDesiredStateRpcRequired())
 	{
 		if (GetLocalRole() >= ROLE_Authority)
 		{
@@ -514,6 +669,8 @@ void AAlsCharacter::SetLocomotionMode(const FGameplayTag& NewLocomotionMode)
 
 void AAlsCharacter::NotifyLocomotionModeChanged(const FGameplayTag& PreviousLocomotionMode)
 {
+	ALS_TRACE_STATE_CHANGED(this, EAlsTraceEventType::LocomotionMode, LocomotionMode.GetTagName());
+
 	ApplyDesiredStance();
 
 	if (LocomotionMode == AlsLocomotionModeTags::Grounded &&
@@ -567,6 +724,8 @@ void AAlsCharacter::NotifyLocomotionModeChanged(const FGameplayTag& PreviousLoco
 		StartRagdolling();
 	}
 
+	OnStateChanged.Broadcast(this, EAlsCharacterStateChange::LocomotionMode);
+
 	OnLocomotionModeChanged(PreviousLocomotionMode);
 }
 
@@ -588,7 +747,7 @@ void AAlsCharacter::SetDesiredAiming(const bool bNewDesiredAiming, const bool bS
 
 	OnDesiredAimingChanged(!bDesiredAiming);
 
-	if (bSendRpc)
+	if (bSendRpc && IsDesiredStateRpcRequired())
 	{
 		if (GetLocalRole() >= ROLE_Authority)
 		{
@@ -634,7 +793,7 @@ void AAlsCharacter::SetDesiredRotationMode(const FGameplayTag& NewDesiredRotatio
 
 	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, DesiredRotationMode, this)
 
-	if (bSendRpc)
+	if (bSendRpc && IsDesiredStateRpcRequired())
 	{
 		if (GetLocalRole() >= ROLE_Authority)
 		{
@@ -673,11 +832,15 @@ void AAlsCharacter::SetRotationMode(const FGameplayTag& NewRotationMode)
 
 void AAlsCharacter::NotifyRotationModeChanged(const FGameplayTag& PreviousRotationMode)
 {
+	ALS_TRACE_STATE_CHANGED(this, EAlsTraceEventType::RotationMode, RotationMode.GetTagName());
+
 	// This prevents the actor from rotating in the last input direction after the
 	// rotation mode has been changed and the actor is not moving at that moment.
 
 	LocomotionState.bRotationTowardsLastInputDirectionBlocked = true;
 
+	OnStateChanged.Broadcast(this, EAlsCharacterStateChange::RotationMode);
+
 	OnRotationModeChanged(PreviousRotationMode);
 }
 
@@ -782,7 +945,7 @@ void AAlsCharacter::SetDesiredStance(const FGameplayTag& NewDesiredStance, const
 
 	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, DesiredStance, this)
 
-	if (bSendRpc)
+	if (bSendRpc && IsDesiredStateRpcRequired())
 	{
 		if (GetLocalRole() >= ROLE_Authority)
 		{
@@ -890,6 +1053,10 @@ void AAlsCharacter::SetStance(const FGameplayTag& NewStance)
 
 		Stance = NewStance;
 
+		ALS_TRACE_STATE_CHANGED(this, EAlsTraceEventType::Stance, Stance.GetTagName());
+
+		OnStateChanged.Broadcast(this, EAlsCharacterStateChange::Stance);
+
 		OnStanceChanged(PreviousStance);
 	}
 }
@@ -912,7 +1079,7 @@ void AAlsCharacter::SetDesiredGait(const FGameplayTag& NewDesiredGait, const boo
 
 	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, DesiredGait, this)
 
-	if (bSendRpc)
+	if (bSendRpc && IsDesiredStateRpcRequired())
 	{
 		if (GetLocalRole() >= ROLE_Authority)
 		{
@@ -943,6 +1110,8 @@ void AAlsCharacter::SetGait(const FGameplayTag& NewGait)
 
 		Gait = NewGait;
 
+		ALS_TRACE_STATE_CHANGED(this, EAlsTraceEventType::Gait, Gait.GetTagName());
+
 		OnGaitChanged(PreviousGait);
 	}
 }
@@ -1056,7 +1225,7 @@ void AAlsCharacter::SetOverlayMode(const FGameplayTag& NewOverlayMode, const boo
 
 	OnOverlayModeChanged(PreviousOverlayMode);
 
-	if (bSendRpc)
+	if (bSendRpc && IsDesiredStateRpcRequired())
 	{
 		if (GetLocalRole() >= ROLE_Authority)
 		{
@@ -1100,6 +1269,8 @@ void AAlsCharacter::SetLocomotionAction(const FGameplayTag& NewLocomotionAction)
 
 void AAlsCharacter::NotifyLocomotionActionChanged(const FGameplayTag& PreviousLocomotionAction)
 {
+	ALS_TRACE_STATE_CHANGED(this, EAlsTraceEventType::LocomotionAction, LocomotionAction.GetTagName());
+
 	if (!LocomotionAction.IsValid())
 	{
 		AlsCharacterMovement->SetInputBlocked(false);
@@ -1124,16 +1295,41 @@ void AAlsCharacter::SetInputDirection(FVector NewInputDirection)
 
 void AAlsCharacter::RefreshInput(const float DeltaTime)
 {
-	if (GetLocalRole() >= ROLE_AutonomousProxy)
+	const auto bHadInput{LocomotionState.bHasInput};
+
+	const auto* CrowdStorage{GetPreparedCrowdStorage()};
+	if (CrowdStorage != nullptr)
 	{
-		SetInputDirection(GetCharacterMovement()->GetCurrentAcceleration() / GetCharacterMovement()->GetMaxAcceleration());
+		if (GetLocalRole() >= ROLE_AutonomousProxy)
+		{
+			SetInputDirection(CrowdStorage->InputDirections[CrowdIndex]);
+		}
+
+		LocomotionState.bHasInput = CrowdStorage->HasInput(CrowdIndex);
+
+		if (LocomotionState.bHasInput)
+		{
+			LocomotionState.InputYawAngle = CrowdStorage->InputYawAngles[CrowdIndex];
+		}
 	}
+	else
+	{
+		if (GetLocalRole() >= ROLE_AutonomousProxy)
+		{
+			SetInputDirection(GetCharacterMovement()->GetCurrentAcceleration() / GetCharacterMovement()->GetMaxAcceleration());
+		}
 
-	LocomotionState.bHasInput = InputDirection.SizeSquared() > UE_KINDA_SMALL_NUMBER;
+		LocomotionState.bHasInput = InputDirection.SizeSquared() > UE_KINDA_SMALL_NUMBER;
+
+		if (LocomotionState.bHasInput)
+		{
+			LocomotionState.InputYawAngle = UE_REAL_TO_FLOAT(UAlsVector::DirectionToAngleXY(InputDirection));
+		}
+	}
 
-	if (LocomotionState.bHasInput)
+	if (LocomotionState.bHasInput && !bHadInput)
 	{
-		LocomotionState.InputYawAngle = UE_REAL_TO_FLOAT(UAlsVector::DirectionToAngleXY(InputDirection));
+		OnStateChanged.Broadcast(this, EAlsCharacterStateChange::InputStarted);
 	}
 }
 
@@ -1144,12 +1340,50 @@ void AAlsCharacter::SetReplicatedViewRotation(const FRotator& NewViewRotation, c
 		ReplicatedViewRotation = NewViewRotation;
 
 		MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, ReplicatedViewRotation, this)
+	}
+
+	if (bSendRpc && GetLocalRole() == ROLE_AutonomousProxy)
+	{
+		SendReplicatedViewRotation();
+	}
+}
 
-		if (bSendRpc && GetLocalRole() == ROLE_AutonomousProxy)
+void AAlsCharacter::SendReplicatedViewRotation()
+{
+	if (ReplicatedViewRotation.Equals(LastSentViewRotation))
+	{
+		return;
+	}
+
+	const auto WorldTime{GetWorld()->GetTimeSeconds()};
+
+	if (IsValid(Settings) && WorldTime - LastSentViewRotationTime < Settings->View.ViewRotationRpcMaxInterval)
+	{
+		const auto AngleDelta{
+			FMath::Max(FMath::Abs(FRotator::NormalizeAxis(ReplicatedViewRotation.Pitch - LastSentViewRotation.Pitch)),
+			           FMath::Abs(FRotator::NormalizeAxis(ReplicatedViewRotation.Yaw - LastSentViewRotation.Yaw)))
+		};
+
+		if (AngleDelta < Settings->View.ViewRotationRpcAngleThreshold)
 		{
-			ServerSetReplicatedViewRotation(ReplicatedViewRotation);
+			return;
 		}
 	}
+
+	LastSentViewRotation = ReplicatedViewRotation;
+	LastSentViewRotationTime = WorldTime;
+
+	if (IsValid(Settings) && Settings->View.bCompressViewRotationRpc)
+	{
+		const auto CompressedPitch{static_cast<uint32>(FRotator::CompressAxisToShort(ReplicatedViewRotation.Pitch))};
+		const auto CompressedYaw{static_cast<uint32>(FRotator::CompressAxisToShort(ReplicatedViewRotation.Yaw))};
+
+		ServerSetReplicatedViewRotationCompressed(CompressedPitch << 16 | CompressedYaw);
+	}
+	else
+	{
+		ServerSetReplicatedViewRotation(ReplicatedViewRotation);
+	}
 }
 
 void AAlsCharacter::ServerSetReplicatedViewRotation_Implementation(const FRotator& NewViewRotation)
@@ -1157,6 +1391,17 @@ void AAlsCharacter::ServerSetReplicatedViewRotation_Implementation(const FRotato
 	SetReplicatedViewRotation(NewViewRotation, false);
 }
 
+void AAlsCharacter::ServerSetReplicatedViewRotationCompressed_Implementation(const uint32 CompressedViewRotation)
+{
+	const FRotator NewViewRotation{
+		FRotator::DecompressAxisFromShort(static_cast<uint16>(CompressedViewRotation >> 16)),
+		FRotator::DecompressAxisFromShort(static_cast<uint16>(CompressedViewRotation & 0xFFFF)),
+		0.0f
+	};
+
+	SetReplicatedViewRotation(NewViewRotation.GetNormalized(), false);
+}
+
 void AAlsCharacter::OnReplicated_ReplicatedViewRotation()
 {
 	CorrectViewNetworkSmoothing(ReplicatedViewRotation, MovementBase.bHasRelativeRotation);
@@ -1312,7 +1557,25 @@ void AAlsCharacter::RefreshViewNetworkSmoothing(const float DeltaTime)
 		NetworkSmoothing.CurrentRotation.Normalize();
 	}
 
-	NetworkSmoothing.ClientTime += DeltaTime;
+	if (GetLocalRole() == ROLE_SimulatedProxy && !GetMesh()->bRecentlyRendered &&
+	    GetMesh()->VisibilityBasedAnimTickOption > EVisibilityBasedAnimTickOption::AlwaysTickPose)
+	{
+		// Nobody sees the animation of this character, so there is no point in interpolating
+		// the view rotation, just snap to the target rotation until the character is rendered again.
+
+		CSV_CUSTOM_STAT(Als, ViewNetworkSmoothingSkips, 1, ECsvCustomStatOp::Accumulate);
+
+		NetworkSmoothing.ClientTime = NetworkSmoothing.ServerTime;
+		NetworkSmoothing.InitialRotation = NetworkSmoothing.TargetRotation;
+		NetworkSmoothing.CurrentRotation = NetworkSmoothing.TargetRotation;
+
+		return;
+	}
+
+	SmoothingTimeStep.Integrate(DeltaTime, [&NetworkSmoothing](const float StepDeltaTime)
+	{
+		NetworkSmoothing.ClientTime += StepDeltaTime;
+	});
 
 	const auto InterpolationAmount{
 		UAlsMath::Clamp01(1.0f - (NetworkSmoothing.ServerTime - NetworkSmoothing.ClientTime) / NetworkSmoothing.Duration)
@@ -1376,22 +1639,41 @@ void AAlsCharacter::RefreshLocomotion()
 {
 	const auto bHadVelocity{LocomotionState.bHasVelocity};
 
-	LocomotionState.Velocity = GetVelocity();
+	const auto* CrowdStorage{GetPreparedCrowdStorage()};
+	if (CrowdStorage != nullptr)
+	{
+		LocomotionState.Velocity = CrowdStorage->Velocities[CrowdIndex];
+		LocomotionState.Speed = CrowdStorage->Speeds[CrowdIndex];
+		LocomotionState.bHasVelocity = CrowdStorage->HasVelocity(CrowdIndex);
+
+		if (LocomotionState.bHasVelocity)
+		{
+			LocomotionState.VelocityYawAngle = CrowdStorage->VelocityYawAngles[CrowdIndex];
+		}
+
+		LocomotionState.bMoving = CrowdStorage->IsMoving(CrowdIndex);
+	}
+	else
+	{
+		LocomotionState.Velocity = GetVelocity();
 
-	// Determine if the character is moving by getting its speed. The speed equals the length
-	// of the horizontal velocity, so it does not take vertical movement into account. If the
-	// character is moving, update the last velocity rotation. This value is saved because it might
-	// be useful to know the last orientation of a movement even after the character has stopped.
+		// Determine if the character is moving by getting its speed. The speed equals the length
+		// of the horizontal velocity, so it does not take vertical movement into account. If the
+		// character is moving, update the last velocity rotation. This value is saved because it might
+		// be useful to know the last orientation of a movement even after the character has stopped.
 
-	LocomotionState.Speed = UE_REAL_TO_FLOAT(LocomotionState.Velocity.Size2D());
+		LocomotionState.Speed = UE_REAL_TO_FLOAT(LocomotionState.Velocity.Size2D());
+		LocomotionState.bHasVelocity = LocomotionState.Speed >= AlsCharacterConstants::HasSpeedThreshold;
 
-	static constexpr auto HasSpeedThreshold{1.0f};
+		if (LocomotionState.bHasVelocity)
+		{
+			LocomotionState.VelocityYawAngle = UE_REAL_TO_FLOAT(UAlsVector::DirectionToAngleXY(LocomotionState.Velocity));
+		}
 
-	LocomotionState.bHasVelocity = LocomotionState.Speed >= HasSpeedThreshold;
+		// Character is moving if has speed and current acceleration, or if the speed is greater than the moving speed threshold.
 
-	if (LocomotionState.bHasVelocity)
-	{
-		LocomotionState.VelocityYawAngle = UE_REAL_TO_FLOAT(UAlsVector::DirectionToAngleXY(LocomotionState.Velocity));
+		LocomotionState.bMoving = (LocomotionState.bHasInput && LocomotionState.bHasVelocity) ||
+		                          LocomotionState.Speed > Settings->MovingSpeedThreshold;
 	}
 
 	if (GetLocalRole() >= ROLE_AutonomousProxy)
@@ -1403,7 +1685,7 @@ void AAlsCharacter::RefreshLocomotion()
 		{
 			FVector DesiredVelocity;
 			if (AlsCharacterMovement->TryConsumePrePenetrationAdjustmentVelocity(DesiredVelocity) &&
-			    DesiredVelocity.Size2D() >= HasSpeedThreshold)
+			    DesiredVelocity.Size2D() >= AlsCharacterConstants::HasSpeedThreshold)
 			{
 				bSendInitialVelocityYawAngle = !bHasDesiredVelocity;
 				bHasDesiredVelocity = true;
@@ -1432,11 +1714,6 @@ void AAlsCharacter::RefreshLocomotion()
 			ServerSetInitialVelocityYawAngle(VelocityYawAngleToSend);
 		}
 	}
-
-	// Character is moving if has speed and current acceleration, or if the speed is greater than the moving speed threshold.
-
-	LocomotionState.bMoving = (LocomotionState.bHasInput && LocomotionState.bHasVelocity) ||
-	                          LocomotionState.Speed > Settings->MovingSpeedThreshold;
 }
 
 void AAlsCharacter::RefreshLocomotionLate()
@@ -1641,8 +1918,15 @@ void AAlsCharacter::RefreshGroundedRotation(const float DeltaTime)
 		}
 		else
 		{
-			TargetYawAngle = UE_REAL_TO_FLOAT(
-				ViewState.Rotation.Yaw + GetMesh()->GetAnimInstance()->GetCurveValue(UAlsConstants::RotationYawOffsetCurveName()));
+			const auto* CrowdStorage{GetPreparedCrowdStorage()};
+
+			const auto RotationYawOffset{
+				CrowdStorage != nullptr
+					? CrowdStorage->RotationYawOffsets[CrowdIndex]
+					: GetMesh()->GetAnimInstance()->GetCurveValue(UAlsConstants::RotationYawOffsetCurveName())
+			};
+
+			TargetYawAngle = UE_REAL_TO_FLOAT(ViewState.Rotation.Yaw + RotationYawOffset);
 		}
 
 		const auto RotationInterpolationSpeed{CalculateGroundedMovingRotationInterpolationSpeed()};
@@ -1782,11 +2066,18 @@ float AAlsCharacter::CalculateGroundedMovingRotationInterpolationSpeed() const
 
 	static constexpr auto DefaultInterpolationSpeed{5.0f};
 
-	const auto InterpolationSpeed{
-		ALS_ENSURE(IsValid(InterpolationSpeedCurve))
-			? InterpolationSpeedCurve->GetFloatValue(FMath::Max(1.0f, AlsCharacterMovement->GetGaitAmount()))
-			: DefaultInterpolationSpeed
-	};
+	const auto* CrowdStorage{GetPreparedCrowdStorage()};
+
+	float InterpolationSpeed;
+
+	if (CrowdStorage == nullptr ||
+	    !CrowdStorage->TryGetRotationInterpolationSpeed(CrowdIndex, InterpolationSpeedCurve,
+	                                                    AlsCharacterMovement->GetGaitAmount(), InterpolationSpeed))
+	{
+		InterpolationSpeed = ALS_ENSURE(IsValid(InterpolationSpeedCurve))
+			                     ? InterpolationSpeedCurve->GetFloatValue(FMath::Max(1.0f, AlsCharacterMovement->GetGaitAmount()))
+			                     : DefaultInterpolationSpeed;
+	}
 
 	static constexpr auto MaxInterpolationSpeedMultiplier{3.0f};
 	static constexpr auto ReferenceViewYawSpeed{300.0f};
@@ -1797,7 +2088,15 @@ float AAlsCharacter::CalculateGroundedMovingRotationInterpolationSpeed() const
 
 void AAlsCharacter::ApplyRotationYawSpeedAnimationCurve(const float DeltaTime)
 {
-	const auto DeltaYawAngle{GetMesh()->GetAnimInstance()->GetCurveValue(UAlsConstants::RotationYawSpeedCurveName()) * DeltaTime};
+	const auto* CrowdStorage{GetPreparedCrowdStorage()};
+
+	const auto RotationYawSpeed{
+		CrowdStorage != nullptr
+			? CrowdStorage->RotationYawSpeeds[CrowdIndex]
+			: GetMesh()->GetAnimInstance()->GetCurveValue(UAlsConstants::RotationYawSpeedCurveName())
+	};
+
+	const auto DeltaYawAngle{RotationYawSpeed * DeltaTime};
 	if (FMath::Abs(DeltaYawAngle) > UE_SMALL_NUMBER)
 	{
 		auto NewRotation{GetActorRotation()};
@@ -1870,8 +2169,15 @@ void AAlsCharacter::RefreshInAirAimingRotation(const float DeltaTime)
 	SetTargetYawAngle(UE_REAL_TO_FLOAT(ViewState.Rotation.Yaw));
 
 	auto NewRotation{GetActorRotation()};
-	NewRotation.Yaw = UAlsRotation::ExponentialDecayAngle(UE_REAL_TO_FLOAT(FMath::UnwindDegrees(NewRotation.Yaw)),
-	                                                      LocomotionState.SmoothTargetYawAngle, DeltaTime, RotationInterpolationSpeed);
+	auto NewYawAngle{UE_REAL_TO_FLOAT(FMath::UnwindDegrees(NewRotation.Yaw))};
+
+	SmoothingTimeStep.Integrate(DeltaTime, [this, &NewYawAngle](const float StepDeltaTime)
+	{
+		NewYawAngle = UAlsRotation::ExponentialDecayAngle(NewYawAngle, LocomotionState.SmoothTargetYawAngle,
+		                                                  StepDeltaTime, RotationInterpolationSpeed);
+	});
+
+	NewRotation.Yaw = NewYawAngle;
 
 	ConstrainAimingRotation(NewRotation, DeltaTime);
 
@@ -1883,8 +2189,15 @@ void AAlsCharacter::SetRotationSmooth(const float TargetYawAngle, const float De
 	SetTargetYawAngle(TargetYawAngle);
 
 	auto NewRotation{GetActorRotation()};
-	NewRotation.Yaw = UAlsRotation::ExponentialDecayAngle(UE_REAL_TO_FLOAT(FMath::UnwindDegrees(NewRotation.Yaw)),
-	                                                      LocomotionState.SmoothTargetYawAngle, DeltaTime, InterpolationSpeed);
+	auto NewYawAngle{UE_REAL_TO_FLOAT(FMath::UnwindDegrees(NewRotation.Yaw))};
+
+	SmoothingTimeStep.Integrate(DeltaTime, [this, &NewYawAngle, InterpolationSpeed](const float StepDeltaTime)
+	{
+		NewYawAngle = UAlsRotation::ExponentialDecayAngle(NewYawAngle, LocomotionState.SmoothTargetYawAngle,
+		                                                  StepDeltaTime, InterpolationSpeed);
+	});
+
+	NewRotation.Yaw = NewYawAngle;
 
 	SetActorRotation(NewRotation);
 }
@@ -1892,11 +2205,26 @@ void AAlsCharacter::SetRotationSmooth(const float TargetYawAngle, const float De
 void AAlsCharacter::SetRotationExtraSmooth(const float TargetYawAngle, const float DeltaTime,
                                            const float InterpolationSpeed, const float TargetYawAngleRotationSpeed)
 {
-	SetTargetYawAngleSmooth(TargetYawAngle, DeltaTime, TargetYawAngleRotationSpeed);
+	LocomotionState.TargetYawAngle = FMath::UnwindDegrees(TargetYawAngle);
 
 	auto NewRotation{GetActorRotation()};
-	NewRotation.Yaw = UAlsRotation::ExponentialDecayAngle(UE_REAL_TO_FLOAT(FMath::UnwindDegrees(NewRotation.Yaw)),
-	                                                      LocomotionState.SmoothTargetYawAngle, DeltaTime, InterpolationSpeed);
+	auto NewYawAngle{UE_REAL_TO_FLOAT(FMath::UnwindDegrees(NewRotation.Yaw))};
+
+	// Both the target yaw angle and the actor rotation are advanced in the same
+	// step, so that the actor follows the intermediate smooth target yaw angles.
+
+	SmoothingTimeStep.Integrate(DeltaTime, [this, &NewYawAngle, InterpolationSpeed, TargetYawAngleRotationSpeed](const float StepDeltaTime)
+	{
+		LocomotionState.SmoothTargetYawAngle = UAlsRotation::InterpolateAngleConstant(
+			LocomotionState.SmoothTargetYawAngle, LocomotionState.TargetYawAngle, StepDeltaTime, TargetYawAngleRotationSpeed);
+
+		NewYawAngle = UAlsRotation::ExponentialDecayAngle(NewYawAngle, LocomotionState.SmoothTargetYawAngle,
+		                                                  StepDeltaTime, InterpolationSpeed);
+	});
+
+	RefreshViewRelativeTargetYawAngle();
+
+	NewRotation.Yaw = NewYawAngle;
 
 	SetActorRotation(NewRotation);
 }
@@ -1931,8 +2259,11 @@ void AAlsCharacter::SetTargetYawAngleSmooth(const float TargetYawAngle, const fl
 {
 	LocomotionState.TargetYawAngle = FMath::UnwindDegrees(TargetYawAngle);
 
-	LocomotionState.SmoothTargetYawAngle = UAlsRotation::InterpolateAngleConstant(
-		LocomotionState.SmoothTargetYawAngle, LocomotionState.TargetYawAngle, DeltaTime, RotationSpeed);
+	SmoothingTimeStep.Integrate(DeltaTime, [this, RotationSpeed](const float StepDeltaTime)
+	{
+		LocomotionState.SmoothTargetYawAngle = UAlsRotation::InterpolateAngleConstant(
+			LocomotionState.SmoothTargetYawAngle, LocomotionState.TargetYawAngle, StepDeltaTime, RotationSpeed);
+	});
 
 	RefreshViewRelativeTargetYawAngle();
 }
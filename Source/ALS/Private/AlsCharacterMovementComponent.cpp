@@ -6,6 +6,7 @@
 #include "Curves/CurveVector.h"
 #include "Engine/World.h"
 #include "GameFramework/Controller.h"
+#include "RootMotionSources/AlsRootMotionSource_Mantling.h"
 #include "Utility/AlsMacros.h"
 #include "Utility/AlsRotation.h"
 #include "Utility/AlsUtility.h"
@@ -13,6 +14,70 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsCharacterMovementComponent)
 
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Saved Moves"), STAT_AlsPooledSavedMoves, STATGROUP_Als)
+DECLARE_MEMORY_STAT(TEXT("Pooled Saved Moves Memory"), STAT_AlsPooledSavedMovesMemory, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Saved Moves Allocated Outside Pool"), STAT_AlsSavedMovesAllocatedOutsidePool, STATGROUP_Als)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Peak Saved Moves"), STAT_AlsPeakSavedMoves, STATGROUP_Als)
+
+namespace AlsSavedMoveCombining
+{
+	bool AreGaitSettingsEquivalent(const FAlsMovementGaitSettings& GaitSettings, const FAlsMovementGaitSettings& OtherGaitSettings)
+	{
+		// The rotation interpolation speed curve is not compared because it doesn't affect the movement simulation.
+
+		return GaitSettings.bAllowDirectionDependentMovementSpeed == OtherGaitSettings.bAllowDirectionDependentMovementSpeed &&
+		       GaitSettings.WalkForwardSpeed == OtherGaitSettings.WalkForwardSpeed &&
+		       GaitSettings.WalkBackwardSpeed == OtherGaitSettings.WalkBackwardSpeed &&
+		       GaitSettings.RunForwardSpeed == OtherGaitSettings.RunForwardSpeed &&
+		       GaitSettings.RunBackwardSpeed == OtherGaitSettings.RunBackwardSpeed &&
+		       GaitSettings.SprintSpeed == OtherGaitSettings.SprintSpeed &&
+		       GaitSettings.AccelerationAndDecelerationAndGroundFrictionCurve ==
+		       OtherGaitSettings.AccelerationAndDecelerationAndGroundFrictionCurve;
+	}
+
+	// Returns the forward and backward max walk speeds that UAlsCharacterMovementComponent::RefreshGroundedMovementSettings()
+	// uses for the max allowed gait. Two max allowed gaits are equivalent if they result in the same speeds.
+	FVector2f GetMaxSpeeds(const FAlsMovementGaitSettings& GaitSettings, const FGameplayTag& MaxAllowedGait)
+	{
+		const auto bDirectionDependent{GaitSettings.bAllowDirectionDependentMovementSpeed};
+
+		if (MaxAllowedGait == AlsGaitTags::Walking)
+		{
+			return {GaitSettings.WalkForwardSpeed, bDirectionDependent ? GaitSettings.WalkBackwardSpeed : GaitSettings.WalkForwardSpeed};
+		}
+
+		if (MaxAllowedGait == AlsGaitTags::Running)
+		{
+			return {GaitSettings.RunForwardSpeed, bDirectionDependent ? GaitSettings.RunBackwardSpeed : GaitSettings.RunForwardSpeed};
+		}
+
+		if (MaxAllowedGait == AlsGaitTags::Sprinting)
+		{
+			return {GaitSettings.SprintSpeed, GaitSettings.SprintSpeed};
+		}
+
+		return {GaitSettings.RunForwardSpeed, GaitSettings.RunForwardSpeed};
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+namespace AlsCorrectionDiagnostics
+{
+	bool IsMantlingRootMotionActive(const FRootMotionSourceGroup& RootMotion)
+	{
+		for (const auto& RootMotionSource : RootMotion.RootMotionSources)
+		{
+			if (RootMotionSource.IsValid() && RootMotionSource->GetScriptStruct() == FAlsRootMotionSource_Mantling::StaticStruct())
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
+#endif
+
 void FAlsCharacterNetworkMoveData::ClientFillNetworkMoveData(const FSavedMove_Character& Move, const ENetworkMoveType MoveType)
 {
 	Super::ClientFillNetworkMoveData(Move, MoveType);
@@ -50,6 +115,8 @@ void FAlsSavedMove::Clear()
 	RotationMode = AlsRotationModeTags::ViewDirection;
 	Stance = AlsStanceTags::Standing;
 	MaxAllowedGait = AlsGaitTags::Running;
+
+	bCombined = false;
 }
 
 void FAlsSavedMove::SetMoveFor(ACharacter* Character, const float NewDeltaTime, const FVector& NewAcceleration,
@@ -68,12 +135,45 @@ void FAlsSavedMove::SetMoveFor(ACharacter* Character, const float NewDeltaTime,
 
 bool FAlsSavedMove::CanCombineWith(const FSavedMovePtr& NewMovePtr, ACharacter* Character, const float MaxDeltaTime) const
 {
+	CSV_CUSTOM_STAT(Als, SavedMoveCombineAttempts, 1, ECsvCustomStatOp::Accumulate);
+
+	if (!Super::CanCombineWith(NewMovePtr, Character, MaxDeltaTime))
+	{
+		return false;
+	}
+
 	const auto* NewMove{static_cast<FAlsSavedMove*>(NewMovePtr.Get())};
 
-	return RotationMode == NewMove->RotationMode &&
-	       Stance == NewMove->Stance &&
-	       MaxAllowedGait == NewMove->MaxAllowedGait &&
-	       Super::CanCombineWith(NewMovePtr, Character, MaxDeltaTime);
+	if (RotationMode == NewMove->RotationMode && Stance == NewMove->Stance && MaxAllowedGait == NewMove->MaxAllowedGait)
+	{
+		CSV_CUSTOM_STAT(Als, SavedMovesCombined, 1, ECsvCustomStatOp::Accumulate);
+		return true;
+	}
+
+	// The combined move is replayed with the rotation mode, stance and max allowed gait of the new move, so the moves can
+	// still be combined if the gait settings they resolve to are the same, since the movement simulation only depends on them.
+
+	const auto* Movement{Cast<UAlsCharacterMovementComponent>(Character->GetCharacterMovement())};
+	if (!IsValid(Movement))
+	{
+		return false;
+	}
+
+	const auto* GaitSettings{Movement->FindGaitSettings(RotationMode, Stance)};
+	const auto* NewGaitSettings{Movement->FindGaitSettings(NewMove->RotationMode, NewMove->Stance)};
+
+	if (GaitSettings == nullptr || NewGaitSettings == nullptr ||
+	    !AlsSavedMoveCombining::AreGaitSettingsEquivalent(*GaitSettings, *NewGaitSettings) ||
+	    AlsSavedMoveCombining::GetMaxSpeeds(*GaitSettings, MaxAllowedGait) !=
+	    AlsSavedMoveCombining::GetMaxSpeeds(*NewGaitSettings, NewMove->MaxAllowedGait))
+	{
+		return false;
+	}
+
+	CSV_CUSTOM_STAT(Als, SavedMovesCombined, 1, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(Als, SavedMovesCombinedWithEquivalentGaitSettings, 1, ECsvCustomStatOp::Accumulate);
+
+	return true;
 }
 
 void FAlsSavedMove::CombineWith(const FSavedMove_Character* PreviousMove, ACharacter* Character,
@@ -97,6 +197,8 @@ void FAlsSavedMove::CombineWith(const FSavedMove_Character* PreviousMove, AChara
 
 	MutablePreviousMove->StartRotation = OriginalRotation;
 	MutablePreviousMove->StartAttachRelativeRotation = OriginalRelativeRotation;
+
+	bCombined = true;
 }
 
 void FAlsSavedMove::PrepMoveFor(ACharacter* Character)
@@ -114,13 +216,64 @@ void FAlsSavedMove::PrepMoveFor(ACharacter* Character)
 	}
 }
 
-FAlsNetworkPredictionData::FAlsNetworkPredictionData(const UCharacterMovementComponent& Movement) : Super{Movement} {}
+FAlsNetworkPredictionData::FAlsNetworkPredictionData(const UCharacterMovementComponent& Movement) : Super{Movement}
+{
+	static constexpr auto ExtraMovesCount{2}; // The pending move and the last acknowledged move.
+
+	PoolCapacity = MaxSavedMoveCount + ExtraMovesCount;
+	MaxFreeMoveCount = PoolCapacity;
+
+	SavedMoves.Reserve(MaxSavedMoveCount);
+	FreeMoves.Reserve(PoolCapacity);
+
+	for (auto i{0}; i < PoolCapacity; i++)
+	{
+		FreeMoves.Emplace(MakeShared<FAlsSavedMove>());
+	}
+
+	INC_DWORD_STAT_BY(STAT_AlsPooledSavedMoves, PoolCapacity);
+	INC_MEMORY_STAT_BY(STAT_AlsPooledSavedMovesMemory, PoolCapacity * sizeof(FAlsSavedMove));
+}
+
+FAlsNetworkPredictionData::~FAlsNetworkPredictionData()
+{
+	DEC_DWORD_STAT_BY(STAT_AlsPooledSavedMoves, PoolCapacity);
+	DEC_MEMORY_STAT_BY(STAT_AlsPooledSavedMovesMemory, PoolCapacity * sizeof(FAlsSavedMove));
+}
 
 FSavedMovePtr FAlsNetworkPredictionData::AllocateNewMove()
 {
+	// Only called when the free list is empty, which shouldn't happen since all moves of the pool are allocated up front.
+
+	INC_DWORD_STAT(STAT_AlsSavedMovesAllocatedOutsidePool);
+	CSV_CUSTOM_STAT(Als, SavedMovesAllocatedOutsidePool, 1, ECsvCustomStatOp::Accumulate);
+
 	return MakeShared<FAlsSavedMove>();
 }
 
+FSavedMovePtr FAlsNetworkPredictionData::CreateSavedMove(ACharacter* Character, const float DeltaTime, const FVector& NewAcceleration)
+{
+	auto NewMove{Super::CreateSavedMove(Character, DeltaTime, NewAcceleration)};
+
+	if (NewMove.IsValid())
+	{
+		// The new move is added to the saved moves only after it is sent to the server, so count it in advance.
+
+		const auto SavedMovesCount{SavedMoves.Num() + 1};
+
+		if (SavedMovesCount > PeakSavedMovesCount)
+		{
+			PeakSavedMovesCount = SavedMovesCount;
+
+			SET_DWORD_STAT(STAT_AlsPeakSavedMoves, PeakSavedMovesCount);
+		}
+
+		CSV_CUSTOM_STAT(Als, PeakSavedMoves, PeakSavedMovesCount, ECsvCustomStatOp::Max);
+	}
+
+	return NewMove;
+}
+
 UAlsCharacterMovementComponent::UAlsCharacterMovementComponent()
 {
 	SetNetworkMoveDataContainer(MoveDataContainer);
@@ -882,6 +1035,139 @@ void UAlsCharacterMovementComponent::MoveAutonomous(const float ClientTimeStamp,
 	}
 }
 
+void UAlsCharacterMovementComponent::ServerMoveHandleClientError(const float ClientTimeStamp, const float DeltaTime, const FVector& Accel,
+                                                                 const FVector& RelativeClientLocation,
+                                                                 UPrimitiveComponent* ClientMovementBase,
+                                                                 const FName ClientBaseBoneName, const uint8 ClientMovementMode)
+{
+	Super::ServerMoveHandleClientError(ClientTimeStamp, DeltaTime, Accel, RelativeClientLocation,
+	                                   ClientMovementBase, ClientBaseBoneName, ClientMovementMode);
+
+	const auto* ServerData{HasValidData() ? GetPredictionData_Server_Character() : nullptr};
+
+	if (ServerData == nullptr || ServerData->PendingAdjustment.bAckGoodMove ||
+	    ServerData->PendingAdjustment.TimeStamp != ClientTimeStamp)
+	{
+		return;
+	}
+
+	// The move was rejected, and the client will receive a correction.
+
+	auto ClientLocation{RelativeClientLocation};
+
+	if (MovementBaseUtility::UseRelativeLocation(ClientMovementBase))
+	{
+		MovementBaseUtility::TransformLocationToWorld(ClientMovementBase, ClientBaseBoneName, RelativeClientLocation, ClientLocation);
+	}
+
+	const auto LocationDelta{UpdatedComponent->GetComponentLocation() - ClientLocation};
+
+	CorrectionStatistics.AddCorrection(UE_REAL_TO_FLOAT(LocationDelta.Size()));
+
+#if !UE_BUILD_SHIPPING
+	if (AlsCorrectionRecords::IsEnabled())
+	{
+		// The state of the move was already applied by MoveAutonomous(), so it can be taken from the component.
+
+		FAlsCorrectionRecord Record;
+		Record.Time = GetWorld()->GetTimeSeconds();
+		Record.MoveTimeStamp = ClientTimeStamp;
+		Record.RotationMode = RotationMode;
+		Record.Stance = Stance;
+		Record.MaxAllowedGait = MaxAllowedGait;
+		Record.MaxSpeeds = AlsSavedMoveCombining::GetMaxSpeeds(GaitSettings, MaxAllowedGait);
+		Record.LocationDelta = LocationDelta;
+		Record.MovementMode = MovementMode;
+		Record.bServer = true;
+		Record.bRootMotionActive = CurrentRootMotion.HasActiveRootMotionSources();
+		Record.bMantlingRootMotionActive = AlsCorrectionDiagnostics::IsMantlingRootMotionActive(CurrentRootMotion);
+
+		RecordCorrection(Record);
+	}
+#endif
+
+	CSV_CUSTOM_STAT(Als, NetworkCorrectionsSent, 1, ECsvCustomStatOp::Accumulate);
+}
+
+void UAlsCharacterMovementComponent::OnClientCorrectionReceived(FNetworkPredictionData_Client_Character& ClientData, const float TimeStamp,
+                                                                const FVector NewLocation, const FVector NewVelocity,
+                                                                UPrimitiveComponent* NewBase, const FName NewBaseBoneName,
+                                                                const bool bHasBase, const bool bBaseRelativePosition,
+                                                                const uint8 ServerMovementMode, const FVector ServerGravityDirection)
+{
+	Super::OnClientCorrectionReceived(ClientData, TimeStamp, NewLocation, NewVelocity, NewBase, NewBaseBoneName,
+	                                  bHasBase, bBaseRelativePosition, ServerMovementMode, ServerGravityDirection);
+
+	// This is called before the correction is applied, so the updated component is still at the predicted location. The new
+	// location is already converted to world space by ClientAdjustPosition_Implementation(), even if it was sent relative to the base.
+
+	const auto LocationDelta{NewLocation - UpdatedComponent->GetComponentLocation()};
+
+	CorrectionStatistics.AddCorrection(UE_REAL_TO_FLOAT(LocationDelta.Size()));
+
+#if !UE_BUILD_SHIPPING
+	if (AlsCorrectionRecords::IsEnabled())
+	{
+		TEnumAsByte<EMovementMode> ServerNetMovementMode;
+		uint8 ServerNetCustomMode;
+		TEnumAsByte<EMovementMode> ServerNetGroundMode;
+		UnpackNetworkMovementMode(ServerMovementMode, ServerNetMovementMode, ServerNetCustomMode, ServerNetGroundMode);
+
+		FAlsCorrectionRecord Record;
+		Record.Time = GetWorld()->GetTimeSeconds();
+		Record.MoveTimeStamp = TimeStamp;
+		Record.LocationDelta = LocationDelta;
+		Record.MovementMode = ServerNetMovementMode;
+
+		// The corrected move is acknowledged before this function is called.
+
+		const auto* Move{static_cast<const FAlsSavedMove*>(ClientData.LastAckedMove.Get())};
+
+		if (Move != nullptr && Move->TimeStamp == TimeStamp)
+		{
+			const auto* MoveGaitSettings{FindGaitSettings(Move->RotationMode, Move->Stance)};
+
+			Record.RotationMode = Move->RotationMode;
+			Record.Stance = Move->Stance;
+			Record.MaxAllowedGait = Move->MaxAllowedGait;
+			Record.MaxSpeeds = AlsSavedMoveCombining::GetMaxSpeeds(MoveGaitSettings != nullptr ? *MoveGaitSettings : GaitSettings,
+			                                                       Move->MaxAllowedGait);
+			Record.bRootMotionActive = Move->SavedRootMotion.HasActiveRootMotionSources();
+			Record.bMantlingRootMotionActive = AlsCorrectionDiagnostics::IsMantlingRootMotionActive(Move->SavedRootMotion);
+			Record.bCombinedMove = Move->bCombined;
+		}
+		else
+		{
+			Record.RotationMode = RotationMode;
+			Record.Stance = Stance;
+			Record.MaxAllowedGait = MaxAllowedGait;
+			Record.MaxSpeeds = AlsSavedMoveCombining::GetMaxSpeeds(GaitSettings, MaxAllowedGait);
+			Record.bRootMotionActive = CurrentRootMotion.HasActiveRootMotionSources();
+			Record.bMantlingRootMotionActive = AlsCorrectionDiagnostics::IsMantlingRootMotionActive(CurrentRootMotion);
+		}
+
+		RecordCorrection(Record);
+	}
+#endif
+
+	CSV_CUSTOM_STAT(Als, NetworkCorrectionsReceived, 1, ECsvCustomStatOp::Accumulate);
+}
+
+#if !UE_BUILD_SHIPPING
+void UAlsCharacterMovementComponent::RecordCorrection(const FAlsCorrectionRecord& Record)
+{
+	// Corrections are only sent on the server and received on the autonomous proxy, so the
+	// buffer is never allocated for simulated proxies or for characters controlled by the server.
+
+	if (!CorrectionRecords.IsValid())
+	{
+		CorrectionRecords = MakeUnique<FAlsCorrectionRecordBuffer>();
+	}
+
+	CorrectionRecords->Record(Record);
+}
+#endif
+
 void UAlsCharacterMovementComponent::SetMovementSettings(UAlsMovementSettings* NewMovementSettings)
 {
 	ALS_ENSURE(IsValid(NewMovementSettings));
@@ -891,6 +1177,18 @@ void UAlsCharacterMovementComponent::SetMovementSettings(UAlsMovementSettings* N
 	RefreshGaitSettings();
 }
 
+const FAlsMovementGaitSettings* UAlsCharacterMovementComponent::FindGaitSettings(const FGameplayTag& RotationModeTag,
+                                                                                const FGameplayTag& StanceTag) const
+{
+	if (!IsValid(MovementSettings))
+	{
+		return nullptr;
+	}
+
+	const auto* StanceSettings{MovementSettings->RotationModes.Find(RotationModeTag)};
+	return StanceSettings != nullptr ? StanceSettings->Stances.Find(StanceTag) : nullptr;
+}
+
 void UAlsCharacterMovementComponent::RefreshGaitSettings()
 {
 	if (!ALS_ENSURE(IsValid(MovementSettings)))
@@ -0,0 +1,206 @@
+#include "AlsCharacterTickSubsystem.h"
+
+#include "AlsCharacter.h"
+#include "AlsCharacterMovementComponent.h"
+#include "Animation/AnimInstance.h"
+#include "Async/ParallelFor.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Curves/CurveFloat.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Settings/AlsCharacterSettings.h"
+#include "Utility/AlsConstants.h"
+#include "Utility/AlsMacros.h"
+#include "Utility/AlsUtility.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsCharacterTickSubsystem)
+
+namespace AlsCharacterTick
+{
+	bool bParallelTick{false};
+
+	FAutoConsoleVariableRef ConsoleVariableParallelTick{
+		TEXT("Als.Character.ParallelTick"), bParallelTick,
+		TEXT("If enabled, the side effect free part of the refresh of ALS characters is run in parallel for all characters ")
+		TEXT("of the world. Only affects characters that begin play after the change."), ECVF_Default
+	};
+}
+
+void FAlsCharacterTickSubsystemTickFunction::ExecuteTick(const float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+                                                         const FGraphEventRef& CompletionGraphEvent)
+{
+	if (IsValid(Subsystem))
+	{
+		Subsystem->Tick(DeltaTime);
+	}
+}
+
+FString FAlsCharacterTickSubsystemTickFunction::DiagnosticMessage()
+{
+	return FString{TEXTVIEW("FAlsCharacterTickSubsystemTickFunction")};
+}
+
+FName FAlsCharacterTickSubsystemTickFunction::DiagnosticContext(bool bDetailed)
+{
+	return FName{TEXTVIEW("AlsCharacterTickSubsystem")};
+}
+
+UAlsCharacterTickSubsystem* UAlsCharacterTickSubsystem::Get(const UWorld* World)
+{
+	return IsValid(World) ? World->GetSubsystem<UAlsCharacterTickSubsystem>() : nullptr;
+}
+
+bool UAlsCharacterTickSubsystem::IsEnabled()
+{
+	return AlsCharacterTick::bParallelTick;
+}
+
+void UAlsCharacterTickSubsystem::Deinitialize()
+{
+	if (TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.UnRegisterTickFunction();
+	}
+
+	Characters.Reset();
+	CrowdStorage.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UAlsCharacterTickSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UAlsCharacterTickSubsystem::RegisterCharacter(AAlsCharacter* Character)
+{
+	check(IsInGameThread())
+
+	if (!ALS_ENSURE(IsValid(Character)) || Character->CrowdIndex != INDEX_NONE)
+	{
+		return;
+	}
+
+	if (!TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.Subsystem = this;
+		TickFunction.TickGroup = TG_PrePhysics;
+		TickFunction.bCanEverTick = true;
+		TickFunction.bStartWithTickEnabled = true;
+		TickFunction.bAllowTickOnDedicatedServer = true;
+		TickFunction.bTickEvenWhenPaused = false;
+
+		TickFunction.RegisterTickFunction(GetWorld()->PersistentLevel);
+	}
+
+	TickFunction.SetTickFunctionEnable(true);
+
+	Characters.Emplace(Character);
+
+	Character->CrowdIndex = CrowdStorage.Add();
+	Character->TickSubsystem = this;
+
+	check(Characters.Num() == CrowdStorage.Num())
+
+	// The character movement component ticks before its owner, so the preparation must wait until it has
+	// moved the character, otherwise the character would consume the velocity and acceleration of the previous frame.
+
+	auto* CharacterMovement{Character->GetCharacterMovement()};
+	TickFunction.AddPrerequisite(CharacterMovement, CharacterMovement->PrimaryComponentTick);
+
+	Character->PrimaryActorTick.AddPrerequisite(this, TickFunction);
+}
+
+void UAlsCharacterTickSubsystem::UnregisterCharacter(AAlsCharacter* Character)
+{
+	check(IsInGameThread())
+
+	if (!IsValid(Character) || Character->TickSubsystem != this || !Characters.IsValidIndex(Character->CrowdIndex))
+	{
+		return;
+	}
+
+	const auto CrowdIndex{Character->CrowdIndex};
+
+	Characters.RemoveAtSwap(CrowdIndex, 1, EAllowShrinking::No);
+	CrowdStorage.RemoveAtSwap(CrowdIndex);
+
+	if (Characters.IsValidIndex(CrowdIndex))
+	{
+		Characters[CrowdIndex]->CrowdIndex = CrowdIndex;
+	}
+
+	Character->CrowdIndex = INDEX_NONE;
+	Character->TickSubsystem = nullptr;
+
+	Character->PrimaryActorTick.RemovePrerequisite(this, TickFunction);
+
+	auto* CharacterMovement{Character->GetCharacterMovement()};
+	if (IsValid(CharacterMovement))
+	{
+		TickFunction.RemovePrerequisite(CharacterMovement, CharacterMovement->PrimaryComponentTick);
+	}
+
+	if (Characters.IsEmpty())
+	{
+		TickFunction.SetTickFunctionEnable(false);
+	}
+}
+
+void UAlsCharacterTickSubsystem::Tick(const float DeltaTime)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("UAlsCharacterTickSubsystem::Tick"), STAT_UAlsCharacterTickSubsystem_Tick, STATGROUP_Als)
+	TRACE_CPUPROFILER_EVENT_SCOPE(__FUNCTION__);
+
+	// Reading the character, movement component and animation instance state is safe here, since the character movement
+	// components have already ticked, this tick function is a prerequisite of the character tick functions, the animation
+	// instances are only updated after the character ticks, and the rest of the game thread work is blocked until the
+	// parallel loop is complete. Gathering the values here, instead of in each character tick, takes the cache misses
+	// of hopping between the character, its components, settings and curves off the game thread.
+
+	ParallelFor(TEXT("AlsCharacterPrepareTick"), Characters.Num(), MinBatchSize, [this](const int32 Index)
+	{
+		const auto* Character{Characters[Index].Get()};
+		if (!IsValid(Character) || !IsValid(Character->Settings) || !IsValid(Character->AlsCharacterMovement))
+		{
+			return;
+		}
+
+		const auto* CharacterMovement{Character->AlsCharacterMovement.Get()};
+
+		CrowdStorage.Velocities[Index] = Character->GetVelocity();
+
+		CrowdStorage.InputDirections[Index] = Character->GetLocalRole() >= ROLE_AutonomousProxy
+			                                      ? (CharacterMovement->GetCurrentAcceleration() /
+			                                         CharacterMovement->GetMaxAcceleration()).GetSafeNormal()
+			                                      : Character->GetInputDirection();
+
+		CrowdStorage.MovingSpeedThresholds[Index] = Character->Settings->MovingSpeedThreshold;
+
+		const auto* AnimationInstance{Character->GetMesh()->GetAnimInstance()};
+		if (IsValid(AnimationInstance))
+		{
+			CrowdStorage.RotationYawSpeeds[Index] = AnimationInstance->GetCurveValue(UAlsConstants::RotationYawSpeedCurveName());
+			CrowdStorage.RotationYawOffsets[Index] = AnimationInstance->GetCurveValue(UAlsConstants::RotationYawOffsetCurveName());
+		}
+
+		const auto* InterpolationSpeedCurve{CharacterMovement->GetGaitSettings().RotationInterpolationSpeedCurve.Get()};
+		const auto GaitAmount{CharacterMovement->GetGaitAmount()};
+
+		CrowdStorage.GaitAmounts[Index] = GaitAmount;
+
+		if (IsValid(InterpolationSpeedCurve))
+		{
+			CrowdStorage.RotationInterpolationSpeedCurves[Index] = InterpolationSpeedCurve;
+			CrowdStorage.RotationInterpolationSpeeds[Index] = InterpolationSpeedCurve->GetFloatValue(FMath::Max(1.0f, GaitAmount));
+		}
+		else
+		{
+			CrowdStorage.RotationInterpolationSpeedCurves[Index] = nullptr;
+		}
+
+		CrowdStorage.Calculate(Index);
+	});
+}
@@ -2,6 +2,7 @@
 
 #include "AlsAnimationInstance.h"
 #include "AlsCharacterMovementComponent.h"
+#include "AlsSceneQuerySubsystem.h"
 #include "DrawDebugHelpers.h"
 #include "TimerManager.h"
 #include "Components/CapsuleComponent.h"
@@ -17,6 +18,7 @@
 #include "Utility/AlsMacros.h"
 #include "Utility/AlsMontageUtility.h"
 #include "Utility/AlsRotation.h"
+#include "Utility/AlsUtility.h"
 #include "Utility/AlsVector.h"
 
 void AAlsCharacter::StartRolling(const float PlayRate)
@@ -145,8 +147,21 @@ bool AAlsCharacter::StartMantlingGrounded()
 
 bool AAlsCharacter::StartMantlingInAir()
 {
-	return LocomotionMode == AlsLocomotionModeTags::InAir && IsLocallyControlled() &&
-	       StartMantling(Settings->Mantling.InAirTrace);
+	if (LocomotionMode != AlsLocomotionModeTags::InAir || !IsLocallyControlled())
+	{
+		return false;
+	}
+
+	// In air mantling is probed every frame, so if the scene query budget is exceeded, the probe can be safely deferred
+	// to one of the next frames. Grounded mantling is started by an explicit player input, so it is never deferred.
+
+	if (UAlsSceneQuerySubsystem::IsBudgetExceeded(GetWorld(), EAlsSceneQuerySource::Mantling))
+	{
+		CSV_CUSTOM_STAT(Als, DegradedQueries, 1, ECsvCustomStatOp::Accumulate);
+		return false;
+	}
+
+	return StartMantling(Settings->Mantling.InAirTrace);
 }
 
 bool AAlsCharacter::IsMantlingAllowedToStart_Implementation() const
@@ -189,6 +204,8 @@ bool AAlsCharacter::StartMantling(const FAlsMantlingTraceSettings& TraceSettings
 			ActorYawAngle + FMath::ClampAngle(ForwardTraceDeltaAngle, -Settings->Mantling.MaxReachAngle, Settings->Mantling.MaxReachAngle))
 	};
 
+	CSV_CUSTOM_STAT(Als, MantlingProbes, 1, ECsvCustomStatOp::Accumulate);
+
 #if ENABLE_DRAW_DEBUG
 	const auto bDisplayDebug{UAlsDebugUtility::ShouldDisplayDebugForActor(this, UAlsConstants::MantlingDebugDisplayName())};
 #endif
@@ -218,10 +235,13 @@ bool AAlsCharacter::StartMantling(const FAlsMantlingTraceSettings& TraceSettings
 	const auto ForwardTraceCapsuleHalfHeight{LedgeHeightDelta * 0.5f};
 
 	FHitResult ForwardTraceHit;
-	GetWorld()->SweepSingleByChannel(ForwardTraceHit, ForwardTraceStart, ForwardTraceEnd,
-	                                 FQuat::Identity, Settings->Mantling.MantlingTraceChannel,
-	                                 FCollisionShape::MakeCapsule(TraceCapsuleRadius, ForwardTraceCapsuleHalfHeight),
-	                                 {ForwardTraceTag, false, this}, Settings->Mantling.MantlingTraceResponses);
+	UAlsSceneQuerySubsystem::SweepSingleByChannel(GetWorld(), EAlsSceneQuerySource::Mantling, ForwardTraceHit,
+	                                              ForwardTraceStart, ForwardTraceEnd, FQuat::Identity,
+	                                              Settings->Mantling.MantlingTraceChannel,
+	                                              FCollisionShape::MakeCapsule(TraceCapsuleRadius, ForwardTraceCapsuleHalfHeight),
+	                                              {ForwardTraceTag, false, this}, Settings->Mantling.MantlingTraceResponses);
+
+	CSV_CUSTOM_STAT(Als, MantlingQueries, 1, ECsvCustomStatOp::Accumulate);
 
 	auto* TargetPrimitive{ForwardTraceHit.GetComponent()};
 
@@ -265,9 +285,12 @@ bool AAlsCharacter::StartMantling(const FAlsMantlingTraceSettings& TraceSettings
 	};
 
 	FHitResult DownwardTraceHit;
-	GetWorld()->SweepSingleByChannel(DownwardTraceHit, DownwardTraceStart, DownwardTraceEnd, FQuat::Identity,
-	                                 Settings->Mantling.MantlingTraceChannel, FCollisionShape::MakeSphere(TraceCapsuleRadius),
-	                                 {DownwardTraceTag, false, this}, Settings->Mantling.MantlingTraceResponses);
+	UAlsSceneQuerySubsystem::SweepSingleByChannel(GetWorld(), EAlsSceneQuerySource::Mantling, DownwardTraceHit,
+	                                              DownwardTraceStart, DownwardTraceEnd, FQuat::Identity,
+	                                              Settings->Mantling.MantlingTraceChannel, FCollisionShape::MakeSphere(TraceCapsuleRadius),
+	                                              {DownwardTraceTag, false, this}, Settings->Mantling.MantlingTraceResponses);
+
+	CSV_CUSTOM_STAT(Als, MantlingQueries, 1, ECsvCustomStatOp::Accumulate);
 
 	const auto SlopeAngleCos{UE_REAL_TO_FLOAT(DownwardTraceHit.ImpactNormal.Z)};
 
@@ -312,9 +335,13 @@ bool AAlsCharacter::StartMantling(const FAlsMantlingTraceSettings& TraceSettings
 
 	const FVector TargetCapsuleLocation{TargetLocation.X, TargetLocation.Y, TargetLocation.Z + CapsuleHalfHeight};
 
-	if (GetWorld()->OverlapBlockingTestByChannel(TargetCapsuleLocation, FQuat::Identity, Settings->Mantling.MantlingTraceChannel,
-	                                             FCollisionShape::MakeCapsule(CapsuleRadius, CapsuleHalfHeight),
-	                                             {TargetLocationTraceTag, false, this}, Settings->Mantling.MantlingTraceResponses))
+	CSV_CUSTOM_STAT(Als, MantlingQueries, 1, ECsvCustomStatOp::Accumulate);
+
+	if (UAlsSceneQuerySubsystem::OverlapBlockingTestByChannel(GetWorld(), EAlsSceneQuerySource::Mantling, TargetCapsuleLocation,
+	                                                          FQuat::Identity, Settings->Mantling.MantlingTraceChannel,
+	                                                          FCollisionShape::MakeCapsule(CapsuleRadius, CapsuleHalfHeight),
+	                                                          {TargetLocationTraceTag, false, this},
+	                                                          Settings->Mantling.MantlingTraceResponses))
 	{
 #if ENABLE_DRAW_DEBUG
 		if (bDisplayDebug)
@@ -352,9 +379,14 @@ bool AAlsCharacter::StartMantling(const FAlsMantlingTraceSettings& TraceSettings
 		UE_REAL_TO_FLOAT(DownwardTraceHit.Location.Z - DownwardTraceEnd.Z) * 0.5f + TraceCapsuleRadius
 	};
 
-	if (GetWorld()->OverlapBlockingTestByChannel(StartLocation, FQuat::Identity, Settings->Mantling.MantlingTraceChannel,
-	                                             FCollisionShape::MakeCapsule(TraceCapsuleRadius, StartLocationTraceCapsuleHalfHeight),
-	                                             {StartLocationTraceTag, false, this}, Settings->Mantling.MantlingTraceResponses))
+	CSV_CUSTOM_STAT(Als, MantlingQueries, 1, ECsvCustomStatOp::Accumulate);
+
+	if (UAlsSceneQuerySubsystem::OverlapBlockingTestByChannel(GetWorld(), EAlsSceneQuerySource::Mantling, StartLocation,
+	                                                          FQuat::Identity, Settings->Mantling.MantlingTraceChannel,
+	                                                          FCollisionShape::MakeCapsule(TraceCapsuleRadius,
+	                                                                                       StartLocationTraceCapsuleHalfHeight),
+	                                                          {StartLocationTraceTag, false, this},
+	                                                          Settings->Mantling.MantlingTraceResponses))
 	{
 #if ENABLE_DRAW_DEBUG
 		if (bDisplayDebug)
@@ -766,6 +798,7 @@ void AAlsCharacter::StartRagdollingImplementation()
 	});
 
 	RagdollingState.PullForce = 0.0f;
+	RagdollingState.DeferredGroundTracesCount = 0;
 
 	if (Settings->Ragdolling.bLimitInitialRagdollSpeed)
 	{
@@ -831,6 +864,8 @@ void AAlsCharacter::RefreshRagdolling(const float DeltaTime)
 		return;
 	}
 
+	CSV_CUSTOM_STAT(Als, Ragdolls, 1, ECsvCustomStatOp::Accumulate);
+
 	// Since we are dealing with physics here, we should not use functions such as USkinnedMeshComponent::GetSocketTransform() as
 	// they may return an incorrect result in situations like when the animation blueprint is not ticking or when URO is enabled.
 
@@ -856,8 +891,28 @@ void AAlsCharacter::RefreshRagdolling(const float DeltaTime)
 	// as the character's location, we don't do that because the camera depends on the
 	// capsule's bottom location, so its removal will cause the camera to behave erratically.
 
-	bool bGrounded;
-	SetActorLocation(RagdollTraceGround(bGrounded), false, nullptr, ETeleportType::TeleportPhysics);
+	static constexpr auto MaxDeferredGroundTracesCount{3};
+
+	if (RagdollingState.DeferredGroundTracesCount < MaxDeferredGroundTracesCount &&
+	    UAlsSceneQuerySubsystem::IsBudgetExceeded(GetWorld(), EAlsSceneQuerySource::Ragdoll))
+	{
+		// The scene query budget is exceeded, so lower the ground trace rate and keep the current capsule height for a few frames.
+
+		RagdollingState.DeferredGroundTracesCount += 1;
+
+		const auto& RagdollLocation{!RagdollTargetLocation.IsZero() ? FVector{RagdollTargetLocation} : GetActorLocation()};
+
+		SetActorLocation({RagdollLocation.X, RagdollLocation.Y, GetActorLocation().Z}, false, nullptr, ETeleportType::TeleportPhysics);
+
+		CSV_CUSTOM_STAT(Als, DegradedQueries, 1, ECsvCustomStatOp::Accumulate);
+	}
+	else
+	{
+		RagdollingState.DeferredGroundTracesCount = 0;
+
+		bool bGrounded;
+		SetActorLocation(RagdollTraceGround(bGrounded), false, nullptr, ETeleportType::TeleportPhysics);
+	}
 
 	// Zero target location means that it hasn't been replicated yet, so we can't apply the logic below.
 
@@ -939,9 +994,11 @@ FVector AAlsCharacter::RagdollTraceGround(bool& bGrounded) const
 	GetCharacterMovement()->InitCollisionParams(QueryParameters, CollisionResponses);
 
 	FHitResult Hit;
-	bGrounded = GetWorld()->SweepSingleByChannel(Hit, TraceStart, TraceEnd, FQuat::Identity,
-	                                             CollisionChannel, FCollisionShape::MakeSphere(CapsuleRadius),
-	                                             QueryParameters, CollisionResponses);
+	bGrounded = UAlsSceneQuerySubsystem::SweepSingleByChannel(GetWorld(), EAlsSceneQuerySource::Ragdoll, Hit, TraceStart, TraceEnd,
+	                                                          FQuat::Identity, CollisionChannel, FCollisionShape::MakeSphere(CapsuleRadius),
+	                                                          QueryParameters, CollisionResponses);
+
+	CSV_CUSTOM_STAT(Als, RagdollQueries, 1, ECsvCustomStatOp::Accumulate);
 
 	// #if ENABLE_DRAW_DEBUG
 	// 	UAlsDebugUtility::DrawSweepSingleSphere(GetWorld(), TraceStart, TraceEnd, CapsuleRadius,
@@ -360,6 +360,77 @@ void AAlsCharacter::DisplayDebugState(const UCanvas* Canvas, const float Scale,
 	Text.Draw(Canvas->Canvas, {HorizontalLocation + ColumnOffset, VerticalLocation});
 
 	VerticalLocation += RowOffset;
+
+	if (!AlsCostTracking::IsEnabled())
+	{
+		return;
+	}
+
+	VerticalLocation += RowOffset;
+
+	TStringBuilder<256> DebugStringBuilder;
+
+	static const auto CostText{FText::AsCultureInvariant(FString{TEXTVIEW("Cost")})};
+
+	Text.Text = CostText;
+	Text.Draw(Canvas->Canvas, {HorizontalLocation, VerticalLocation});
+
+	DebugStringBuilder.Appendf(TEXT("%.3f ms"), Costs.GetTotalAverageMilliseconds());
+
+	Text.Text = FText::AsCultureInvariant(FString{DebugStringBuilder});
+	Text.Draw(Canvas->Canvas, {HorizontalLocation + ColumnOffset, VerticalLocation});
+
+	DebugStringBuilder.Reset();
+
+	VerticalLocation += RowOffset;
+
+	for (auto i{0}; i < AlsCostTracking::CategoriesCount; i++)
+	{
+		const auto Category{static_cast<EAlsCostCategory>(i)};
+
+		Text.Text = FText::AsCultureInvariant(FString{AlsCostTracking::GetCategoryName(Category)});
+		Text.Draw(Canvas->Canvas, {HorizontalLocation, VerticalLocation});
+
+		DebugStringBuilder.Appendf(TEXT("%.3f ms"), Costs.GetAverageMilliseconds(Category));
+
+		Text.Text = FText::AsCultureInvariant(FString{DebugStringBuilder});
+		Text.Draw(Canvas->Canvas, {HorizontalLocation + ColumnOffset, VerticalLocation});
+
+		DebugStringBuilder.Reset();
+
+		VerticalLocation += RowOffset;
+	}
+
+	static constexpr auto CostliestCharactersCount{5};
+
+	TArray<const AAlsCharacter*> CostliestCharacters;
+	AlsCostTracking::GetCostliestCharacters(GetWorld(), CostliestCharactersCount, CostliestCharacters);
+
+	VerticalLocation += RowOffset;
+
+	static const auto CostliestCharactersText{FText::AsCultureInvariant(FString{TEXTVIEW("Costliest Characters")})};
+
+	Text.Text = CostliestCharactersText;
+	Text.Draw(Canvas->Canvas, {HorizontalLocation, VerticalLocation});
+
+	VerticalLocation += RowOffset;
+
+	for (const auto* Character : CostliestCharacters)
+	{
+		Text.SetColor(Character == this ? FLinearColor::Yellow : FLinearColor::White);
+
+		Text.Text = FText::AsCultureInvariant(Character->GetName());
+		Text.Draw(Canvas->Canvas, {HorizontalLocation, VerticalLocation});
+
+		DebugStringBuilder.Appendf(TEXT("%.3f ms"), Character->GetCosts().GetTotalAverageMilliseconds());
+
+		Text.Text = FText::AsCultureInvariant(FString{DebugStringBuilder});
+		Text.Draw(Canvas->Canvas, {HorizontalLocation + ColumnOffset, VerticalLocation});
+
+		DebugStringBuilder.Reset();
+
+		VerticalLocation += RowOffset;
+	}
 }
 
 void AAlsCharacter::DisplayDebugShapes(const UCanvas* Canvas, const float Scale,
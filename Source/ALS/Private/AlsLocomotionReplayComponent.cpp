@@ -0,0 +1,483 @@
+#include "AlsLocomotionReplayComponent.h"
+
+#include "AlsCharacter.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Utility/AlsLog.h"
+#include "Utility/AlsMacros.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsLocomotionReplayComponent)
+
+#if ALLOW_CONSOLE
+namespace AlsLocomotionReplay
+{
+	UAlsLocomotionReplayComponent* FindOrAddReplayComponent(const UWorld* World)
+	{
+		const auto* Player{IsValid(World) ? World->GetFirstPlayerController() : nullptr};
+		auto* Character{IsValid(Player) ? Cast<AAlsCharacter>(Player->GetPawn()) : nullptr};
+
+		if (!IsValid(Character))
+		{
+			UE_LOG(LogAls, Warning, TEXT("Locomotion replay requires the first player controller to possess an ALS character."));
+			return nullptr;
+		}
+
+		auto* ReplayComponent{Character->FindComponentByClass<UAlsLocomotionReplayComponent>()};
+		if (!IsValid(ReplayComponent))
+		{
+			ReplayComponent = NewObject<UAlsLocomotionReplayComponent>(Character);
+			ReplayComponent->RegisterComponent();
+		}
+
+		return ReplayComponent;
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs RecordCommand{
+		TEXT("Als.Replay.Record"),
+		TEXT("Starts recording the locomotion replay of the character possessed by the first player controller."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Arguments, UWorld* World)
+		{
+			auto* ReplayComponent{FindOrAddReplayComponent(World)};
+			if (IsValid(ReplayComponent))
+			{
+				ReplayComponent->StartRecording();
+			}
+		})
+	};
+
+	FAutoConsoleCommandWithWorldAndArgs StopCommand{
+		TEXT("Als.Replay.Stop"),
+		TEXT("Stops the locomotion replay recording and saves it to the specified file, or stops the locomotion replay playback."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Arguments, UWorld* World)
+		{
+			auto* ReplayComponent{FindOrAddReplayComponent(World)};
+			if (!IsValid(ReplayComponent))
+			{
+				return;
+			}
+
+			if (ReplayComponent->GetMode() == EAlsLocomotionReplayMode::Recording)
+			{
+				ReplayComponent->StopRecording(Arguments.IsEmpty() ? FString{TEXTVIEW("AlsLocomotion.alsreplay")} : Arguments[0]);
+			}
+			else
+			{
+				ReplayComponent->StopPlayback();
+			}
+		})
+	};
+
+	FAutoConsoleCommandWithWorldAndArgs PlayCommand{
+		TEXT("Als.Replay.Play"),
+		TEXT("Plays back the locomotion replay from the specified file on the character possessed by the first player controller."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Arguments, UWorld* World)
+		{
+			auto* ReplayComponent{FindOrAddReplayComponent(World)};
+			if (IsValid(ReplayComponent))
+			{
+				ReplayComponent->StartPlayback(Arguments.IsEmpty() ? FString{TEXTVIEW("AlsLocomotion.alsreplay")} : Arguments[0]);
+			}
+		})
+	};
+}
+#endif
+
+FArchive& operator<<(FArchive& Archive, FAlsLocomotionReplayStartState& StartState)
+{
+	Archive << StartState.Location;
+	Archive << StartState.Rotation;
+	Archive << StartState.Velocity;
+	Archive << StartState.ViewRotation;
+	Archive << StartState.MovementMode;
+	Archive << StartState.CustomMovementMode;
+	Archive << StartState.LocomotionMode;
+	Archive << StartState.DesiredRotationMode;
+	Archive << StartState.DesiredStance;
+	Archive << StartState.DesiredGait;
+	Archive << StartState.ViewMode;
+	Archive << StartState.OverlayMode;
+	Archive << StartState.bDesiredAiming;
+
+	return Archive;
+}
+
+FArchive& operator<<(FArchive& Archive, FAlsLocomotionReplayFrame& Frame)
+{
+	Archive << Frame.DeltaTime;
+	Archive << Frame.MovementInput;
+	Archive << Frame.ControlRotation;
+	Archive << Frame.DesiredRotationMode;
+	Archive << Frame.DesiredStance;
+	Archive << Frame.DesiredGait;
+	Archive << Frame.ViewMode;
+	Archive << Frame.bDesiredAiming;
+	Archive << Frame.Checksum;
+
+	return Archive;
+}
+
+UAlsLocomotionReplayComponent::UAlsLocomotionReplayComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
+
+	bTickInEditor = false;
+}
+
+void UAlsLocomotionReplayComponent::OnRegister()
+{
+	Character = Cast<AAlsCharacter>(GetOwner());
+
+	Super::OnRegister();
+}
+
+void UAlsLocomotionReplayComponent::RegisterComponentTickFunctions(const bool bRegister)
+{
+	Super::RegisterComponentTickFunctions(bRegister);
+
+	if (bRegister)
+	{
+		// Tick after the owner to record or verify the character state at the end of the frame.
+
+		AddTickPrerequisiteActor(GetOwner());
+	}
+}
+
+void UAlsLocomotionReplayComponent::TickComponent(const float DeltaTime, const ELevelTick TickType,
+                                                  FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (!IsValid(Character))
+	{
+		return;
+	}
+
+	if (Mode == EAlsLocomotionReplayMode::Recording)
+	{
+		RecordFrame(DeltaTime);
+	}
+	else if (Mode == EAlsLocomotionReplayMode::Playing)
+	{
+		VerifyFrame(DeltaTime);
+	}
+}
+
+void UAlsLocomotionReplayComponent::StartRecording()
+{
+	if (!ALS_ENSURE(IsValid(Character)) || !ALS_ENSURE(Character->GetLocalRole() >= ROLE_Authority))
+	{
+		return;
+	}
+
+	StopPlayback();
+
+	TagNames.Reset();
+	Frames.Reset();
+
+	RecordStartState();
+
+	Mode = EAlsLocomotionReplayMode::Recording;
+	SetComponentTickEnabled(true);
+}
+
+bool UAlsLocomotionReplayComponent::StopRecording(const FString& FilePath)
+{
+	if (Mode != EAlsLocomotionReplayMode::Recording)
+	{
+		return false;
+	}
+
+	Mode = EAlsLocomotionReplayMode::None;
+	SetComponentTickEnabled(false);
+
+	TArray<uint8> Data;
+	FMemoryWriter Writer{Data};
+
+	SerializeReplay(Writer);
+
+	const auto ResolvedFilePath{ResolveFilePath(FilePath)};
+
+	if (!FFileHelper::SaveArrayToFile(Data, *ResolvedFilePath))
+	{
+		UE_LOG(LogAls, Error, TEXT("Failed to save the locomotion replay to %s."), *ResolvedFilePath);
+		return false;
+	}
+
+	UE_LOG(LogAls, Log, TEXT("Saved the locomotion replay with %d frames (%d bytes) to %s."),
+	       Frames.Num(), Data.Num(), *ResolvedFilePath);
+	return true;
+}
+
+bool UAlsLocomotionReplayComponent::StartPlayback(const FString& FilePath)
+{
+	if (!ALS_ENSURE(IsValid(Character)) || !ALS_ENSURE(Character->GetLocalRole() >= ROLE_Authority))
+	{
+		return false;
+	}
+
+	const auto ResolvedFilePath{ResolveFilePath(FilePath)};
+
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *ResolvedFilePath))
+	{
+		UE_LOG(LogAls, Error, TEXT("Failed to load the locomotion replay from %s."), *ResolvedFilePath);
+		return false;
+	}
+
+	FMemoryReader Reader{Data};
+
+	SerializeReplay(Reader);
+
+	if (Reader.IsError() || Frames.IsEmpty())
+	{
+		UE_LOG(LogAls, Error, TEXT("The locomotion replay in %s is invalid or empty."), *ResolvedFilePath);
+
+		TagNames.Reset();
+		Frames.Reset();
+		return false;
+	}
+
+	ApplyStartState();
+
+	FrameIndex = 0;
+	FirstDivergedFrameIndex = INDEX_NONE;
+	DivergedFramesCount = 0;
+
+	ApplyFrame(Frames[FrameIndex]);
+
+	Mode = EAlsLocomotionReplayMode::Playing;
+	SetComponentTickEnabled(true);
+
+	UE_LOG(LogAls, Log, TEXT("Started playing back the locomotion replay with %d frames from %s."), Frames.Num(), *ResolvedFilePath);
+	return true;
+}
+
+void UAlsLocomotionReplayComponent::StopPlayback()
+{
+	if (Mode != EAlsLocomotionReplayMode::Playing)
+	{
+		return;
+	}
+
+	Mode = EAlsLocomotionReplayMode::None;
+	SetComponentTickEnabled(false);
+
+	if (DivergedFramesCount <= 0)
+	{
+		UE_LOG(LogAls, Log, TEXT("Locomotion replay finished, %d of %d frames matched the recording."), FrameIndex, Frames.Num());
+	}
+	else
+	{
+		UE_LOG(LogAls, Warning, TEXT("Locomotion replay finished, %d of %d frames diverged from the recording, starting from frame %d."),
+		       DivergedFramesCount, FrameIndex, FirstDivergedFrameIndex);
+	}
+}
+
+uint32 UAlsLocomotionReplayComponent::CalculateStateChecksum() const
+{
+	if (!IsValid(Character))
+	{
+		return 0;
+	}
+
+	uint32 Checksum{0};
+
+	const auto HashValue{
+		[&Checksum](const auto& Value)
+		{
+			Checksum = FCrc::MemCrc32(&Value, sizeof(Value), Checksum);
+		}
+	};
+
+	const auto HashTag{
+		[&Checksum](const FGameplayTag& Tag)
+		{
+			// Name indices are not stable between runs, so hash the tag string instead.
+
+			TStringBuilder<256> TagString;
+			Tag.GetTagName().AppendString(TagString);
+
+			Checksum = FCrc::StrCrc32(TagString.ToString(), Checksum);
+		}
+	};
+
+	const auto& LocomotionState{Character->GetLocomotionState()};
+
+	HashValue(Character->GetActorLocation());
+	HashValue(Character->GetActorQuat());
+	HashValue(Character->GetCharacterMovement()->Velocity);
+	HashValue(Character->GetMesh()->GetComponentQuat());
+	HashValue(LocomotionState.TargetYawAngle);
+	HashValue(LocomotionState.SmoothTargetYawAngle);
+	HashValue(LocomotionState.ViewRelativeTargetYawAngle);
+
+	HashTag(Character->GetLocomotionMode());
+	HashTag(Character->GetRotationMode());
+	HashTag(Character->GetStance());
+	HashTag(Character->GetGait());
+	HashTag(Character->GetLocomotionAction());
+
+	return Checksum;
+}
+
+FString UAlsLocomotionReplayComponent::ResolveFilePath(const FString& FilePath)
+{
+	return FPaths::IsRelative(FilePath) ? FPaths::Combine(FPaths::ProjectSavedDir(), FilePath) : FilePath;
+}
+
+void UAlsLocomotionReplayComponent::SerializeReplay(FArchive& Archive)
+{
+	auto Magic{FileMagic};
+	auto Version{FileVersion};
+
+	Archive << Magic;
+	Archive << Version;
+
+	if (Archive.IsLoading() && (Magic != FileMagic || Version != FileVersion))
+	{
+		Archive.SetError();
+		return;
+	}
+
+	Archive << StartState;
+	Archive << TagNames;
+	Archive << Frames;
+}
+
+uint8 UAlsLocomotionReplayComponent::FindOrAddTagIndex(const FGameplayTag& Tag)
+{
+	const auto Index{TagNames.AddUnique(Tag.GetTagName())};
+	ALS_ENSURE(Index <= MAX_uint8);
+
+	return static_cast<uint8>(Index);
+}
+
+FGameplayTag UAlsLocomotionReplayComponent::GetTag(const uint8 Index) const
+{
+	return TagNames.IsValidIndex(Index) ? FGameplayTag::RequestGameplayTag(TagNames[Index], false) : FGameplayTag::EmptyTag;
+}
+
+void UAlsLocomotionReplayComponent::RecordStartState()
+{
+	const auto* CharacterMovement{Character->GetCharacterMovement()};
+
+	StartState.Location = Character->GetActorLocation();
+	StartState.Rotation = Character->GetActorRotation();
+	StartState.Velocity = CharacterMovement->Velocity;
+	StartState.ViewRotation = Character->GetControlRotation();
+	StartState.MovementMode = CharacterMovement->MovementMode;
+	StartState.CustomMovementMode = CharacterMovement->CustomMovementMode;
+	StartState.LocomotionMode = FindOrAddTagIndex(Character->GetLocomotionMode());
+	StartState.DesiredRotationMode = FindOrAddTagIndex(Character->GetDesiredRotationMode());
+	StartState.DesiredStance = FindOrAddTagIndex(Character->GetDesiredStance());
+	StartState.DesiredGait = FindOrAddTagIndex(Character->GetDesiredGait());
+	StartState.ViewMode = FindOrAddTagIndex(Character->GetViewMode());
+	StartState.OverlayMode = FindOrAddTagIndex(Character->GetOverlayMode());
+	StartState.bDesiredAiming = Character->IsDesiredAiming();
+}
+
+void UAlsLocomotionReplayComponent::ApplyStartState() const
+{
+	auto* CharacterMovement{Character->GetCharacterMovement()};
+
+	Character->SetActorLocationAndRotation(StartState.Location, StartState.Rotation, false, nullptr, ETeleportType::ResetPhysics);
+
+	CharacterMovement->SetMovementMode(static_cast<EMovementMode>(StartState.MovementMode), StartState.CustomMovementMode);
+	CharacterMovement->Velocity = StartState.Velocity;
+
+	auto* Controller{Character->GetController()};
+	if (IsValid(Controller))
+	{
+		Controller->SetControlRotation(StartState.ViewRotation);
+	}
+
+	Character->SetDesiredAiming(StartState.bDesiredAiming);
+	Character->SetDesiredRotationMode(GetTag(StartState.DesiredRotationMode));
+	Character->SetDesiredStance(GetTag(StartState.DesiredStance));
+	Character->SetDesiredGait(GetTag(StartState.DesiredGait));
+	Character->SetViewMode(GetTag(StartState.ViewMode));
+	Character->SetOverlayMode(GetTag(StartState.OverlayMode));
+
+	if (Character->GetLocomotionMode() != GetTag(StartState.LocomotionMode))
+	{
+		UE_LOG(LogAls, Warning, TEXT("Locomotion replay: the locomotion mode %s doesn't match the recorded %s after restoring")
+		       TEXT(" the movement mode, the playback may diverge."), *Character->GetLocomotionMode().ToString(),
+		       *GetTag(StartState.LocomotionMode).ToString());
+	}
+}
+
+void UAlsLocomotionReplayComponent::RecordFrame(const float DeltaTime)
+{
+	auto& Frame{Frames.AddDefaulted_GetRef()};
+
+	Frame.DeltaTime = DeltaTime;
+	Frame.MovementInput = FVector3f{Character->GetLastMovementInputVector()};
+	Frame.ControlRotation = FRotator3f{Character->GetControlRotation()};
+	Frame.DesiredRotationMode = FindOrAddTagIndex(Character->GetDesiredRotationMode());
+	Frame.DesiredStance = FindOrAddTagIndex(Character->GetDesiredStance());
+	Frame.DesiredGait = FindOrAddTagIndex(Character->GetDesiredGait());
+	Frame.ViewMode = FindOrAddTagIndex(Character->GetViewMode());
+	Frame.bDesiredAiming = Character->IsDesiredAiming();
+	Frame.Checksum = CalculateStateChecksum();
+}
+
+void UAlsLocomotionReplayComponent::ApplyFrame(const FAlsLocomotionReplayFrame& Frame) const
+{
+	// The movement input is consumed by the character movement component on the next frame.
+
+	Character->AddMovementInput(FVector{Frame.MovementInput}, 1.0f, true);
+
+	auto* Controller{Character->GetController()};
+	if (IsValid(Controller))
+	{
+		Controller->SetControlRotation(FRotator{Frame.ControlRotation});
+	}
+
+	Character->SetDesiredAiming(Frame.bDesiredAiming);
+	Character->SetDesiredRotationMode(GetTag(Frame.DesiredRotationMode));
+	Character->SetDesiredStance(GetTag(Frame.DesiredStance));
+	Character->SetDesiredGait(GetTag(Frame.DesiredGait));
+	Character->SetViewMode(GetTag(Frame.ViewMode));
+}
+
+void UAlsLocomotionReplayComponent::VerifyFrame(const float DeltaTime)
+{
+	const auto& Frame{Frames[FrameIndex]};
+
+	if (!FMath::IsNearlyEqual(DeltaTime, Frame.DeltaTime, UE_KINDA_SMALL_NUMBER))
+	{
+		UE_LOG(LogAls, Verbose, TEXT("Locomotion replay frame %d: delta time %f doesn't match the recorded %f,")
+		       TEXT(" use a fixed time step for deterministic playback."), FrameIndex, DeltaTime, Frame.DeltaTime);
+	}
+
+	if (CalculateStateChecksum() != Frame.Checksum)
+	{
+		if (FirstDivergedFrameIndex == INDEX_NONE)
+		{
+			FirstDivergedFrameIndex = FrameIndex;
+
+			UE_LOG(LogAls, Warning, TEXT("Locomotion replay diverged from the recording at frame %d."), FrameIndex);
+		}
+
+		DivergedFramesCount += 1;
+	}
+
+	FrameIndex += 1;
+
+	if (FrameIndex >= Frames.Num())
+	{
+		StopPlayback();
+		return;
+	}
+
+	ApplyFrame(Frames[FrameIndex]);
+}
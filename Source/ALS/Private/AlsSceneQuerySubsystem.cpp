@@ -0,0 +1,455 @@
+#include "AlsSceneQuerySubsystem.h"
+
+#include "Engine/OverlapResult.h"
+#include "HAL/IConsoleManager.h"
+#include "Utility/AlsCostTracking.h"
+#include "Utility/AlsMacros.h"
+#include "Utility/AlsUtility.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsSceneQuerySubsystem)
+
+namespace AlsSceneQuery
+{
+	int32 TotalBudget{0};
+
+	TStaticArray<int32, UAlsSceneQuerySubsystem::SourcesCount> SourceBudgets{InPlace, 0};
+
+	FAutoConsoleVariableRef ConsoleVariableTotalBudget{
+		TEXT("Als.SceneQueries.Budget"), TotalBudget,
+		TEXT("Maximum number of ALS scene queries per frame for all sources combined, 0 means unlimited."), ECVF_Default
+	};
+
+	FAutoConsoleVariableRef ConsoleVariableGroundPredictionBudget{
+		TEXT("Als.SceneQueries.Budget.GroundPrediction"), SourceBudgets[static_cast<int32>(EAlsSceneQuerySource::GroundPrediction)],
+		TEXT("Maximum number of ground prediction sweeps per frame, 0 means unlimited. ")
+		TEXT("When exceeded, characters reuse their last ground prediction result."), ECVF_Default
+	};
+
+	FAutoConsoleVariableRef ConsoleVariableMantlingBudget{
+		TEXT("Als.SceneQueries.Budget.Mantling"), SourceBudgets[static_cast<int32>(EAlsSceneQuerySource::Mantling)],
+		TEXT("Maximum number of mantling queries per frame, 0 means unlimited. ")
+		TEXT("When exceeded, in air mantling probes are deferred to the next frames."), ECVF_Default
+	};
+
+	FAutoConsoleVariableRef ConsoleVariableRagdollBudget{
+		TEXT("Als.SceneQueries.Budget.Ragdoll"), SourceBudgets[static_cast<int32>(EAlsSceneQuerySource::Ragdoll)],
+		TEXT("Maximum number of ragdoll ground sweeps per frame, 0 means unlimited. ")
+		TEXT("When exceeded, ragdolls trace the ground at a lower rate."), ECVF_Default
+	};
+
+	FAutoConsoleVariableRef ConsoleVariableCameraBudget{
+		TEXT("Als.SceneQueries.Budget.Camera"), SourceBudgets[static_cast<int32>(EAlsSceneQuerySource::Camera)],
+		TEXT("Maximum number of camera queries per frame, 0 means unlimited. Camera queries are never skipped, ")
+		TEXT("but are still accounted against the total budget."), ECVF_Default
+	};
+
+	FAutoConsoleVariableRef ConsoleVariableFootIkBudget{
+		TEXT("Als.SceneQueries.Budget.FootIk"), SourceBudgets[static_cast<int32>(EAlsSceneQuerySource::FootIk)],
+		TEXT("Maximum number of foot IK traces per frame, 0 means unlimited. Foot IK traces are never skipped, ")
+		TEXT("but are still accounted against the total budget."), ECVF_Default
+	};
+
+	FAutoConsoleVariableRef ConsoleVariableFootstepsBudget{
+		TEXT("Als.SceneQueries.Budget.Footsteps"), SourceBudgets[static_cast<int32>(EAlsSceneQuerySource::Footsteps)],
+		TEXT("Maximum number of footstep surface traces per frame, 0 means unlimited. ")
+		TEXT("When exceeded, footstep effects are spawned for the default surface without a decal."), ECVF_Default
+	};
+}
+
+UAlsSceneQuerySubsystem* UAlsSceneQuerySubsystem::Get(const UWorld* World)
+{
+	return IsValid(World) ? World->GetSubsystem<UAlsSceneQuerySubsystem>() : nullptr;
+}
+
+void UAlsSceneQuerySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Queries whose results affect gameplay or the view are more important than purely cosmetic ones.
+
+	SourcePriorities[static_cast<int32>(EAlsSceneQuerySource::Camera)] = 50;
+	SourcePriorities[static_cast<int32>(EAlsSceneQuerySource::Mantling)] = 40;
+	SourcePriorities[static_cast<int32>(EAlsSceneQuerySource::Ragdoll)] = 30;
+	SourcePriorities[static_cast<int32>(EAlsSceneQuerySource::FootIk)] = 20;
+	SourcePriorities[static_cast<int32>(EAlsSceneQuerySource::GroundPrediction)] = 10;
+	SourcePriorities[static_cast<int32>(EAlsSceneQuerySource::Footsteps)] = 0;
+
+	TraceDelegate.BindUObject(this, &ThisClass::OnTraceCompleted);
+
+	WorldTickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &ThisClass::OnWorldTickStart);
+}
+
+void UAlsSceneQuerySubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldTickStart.Remove(WorldTickStartHandle);
+	WorldTickStartHandle.Reset();
+
+	TraceDelegate.Unbind();
+
+	{
+		FScopeLock Lock{&CriticalSection};
+
+		PendingRequests.Reset();
+		DispatchedHandleIds.Reset();
+		Results.Reset();
+	}
+
+	Super::Deinitialize();
+}
+
+void UAlsSceneQuerySubsystem::Tick(const float DeltaTime)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("UAlsSceneQuerySubsystem::Tick"), STAT_UAlsSceneQuerySubsystem_Tick, STATGROUP_Als)
+	TRACE_CPUPROFILER_EVENT_SCOPE(__FUNCTION__);
+
+	Super::Tick(DeltaTime);
+
+	DispatchRequests();
+
+	FScopeLock Lock{&CriticalSection};
+
+	for (auto Iterator{Results.CreateIterator()}; Iterator; ++Iterator)
+	{
+		if (GFrameCounter - Iterator.Value().CompleteFrame > MaxResultAgeFrames)
+		{
+			Iterator.RemoveCurrent();
+		}
+	}
+}
+
+TStatId UAlsSceneQuerySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAlsSceneQuerySubsystem, STATGROUP_Tickables)
+}
+
+bool UAlsSceneQuerySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UAlsSceneQuerySubsystem::SetSourcePriority(const EAlsSceneQuerySource Source, const int32 Priority)
+{
+	check(IsInGameThread())
+
+	SourcePriorities[static_cast<int32>(Source)] = Priority;
+}
+
+int32 UAlsSceneQuerySubsystem::GetTotalBudget()
+{
+	return FMath::Max(0, AlsSceneQuery::TotalBudget);
+}
+
+int32 UAlsSceneQuerySubsystem::GetSourceBudget(const EAlsSceneQuerySource Source)
+{
+	return FMath::Max(0, AlsSceneQuery::SourceBudgets[static_cast<int32>(Source)]);
+}
+
+void UAlsSceneQuerySubsystem::OnWorldTickStart(UWorld* World, const ELevelTick TickType, const float DeltaTime)
+{
+	if (World != GetWorld())
+	{
+		return;
+	}
+
+	// Start the frame with the deferred queries dispatched at the end of the previous frame, since their traces
+	// run during this one. Otherwise, this frame's immediate queries would get the whole budget on top of them.
+
+	for (auto i{0}; i < SourcesCount; i++)
+	{
+		SourceQueriesCounts[i].store(DispatchedQueriesCounts[i], std::memory_order_relaxed);
+		DispatchedQueriesCounts[i] = 0;
+	}
+}
+
+int32 UAlsSceneQuerySubsystem::GetTotalQueriesCount() const
+{
+	auto QueriesCount{0};
+
+	for (const auto& SourceQueriesCount : SourceQueriesCounts)
+	{
+		QueriesCount += SourceQueriesCount.load(std::memory_order_relaxed);
+	}
+
+	return QueriesCount;
+}
+
+bool UAlsSceneQuerySubsystem::IsBudgetExceeded(const EAlsSceneQuerySource Source) const
+{
+	const auto SourceBudget{GetSourceBudget(Source)};
+	if (SourceBudget > 0 && GetSourceQueriesCount(Source) >= SourceBudget)
+	{
+		return true;
+	}
+
+	const auto TotalBudget{GetTotalBudget()};
+	return TotalBudget > 0 && GetTotalQueriesCount() >= TotalBudget;
+}
+
+bool UAlsSceneQuerySubsystem::IsBudgetExceeded(const UWorld* World, const EAlsSceneQuerySource Source)
+{
+	const auto* Subsystem{Get(World)};
+	return IsValid(Subsystem) && Subsystem->IsBudgetExceeded(Source);
+}
+
+FAlsSceneQueryHandle UAlsSceneQuerySubsystem::RequestLineTrace(const EAlsSceneQuerySource Source, const FVector& Start,
+                                                               const FVector& End, const ECollisionChannel Channel,
+                                                               const FCollisionQueryParams& QueryParams,
+                                                               const FCollisionResponseParams& ResponseParams)
+{
+	FRequest Request;
+	Request.Source = Source;
+	Request.Start = Start;
+	Request.End = End;
+	Request.Rotation = FQuat::Identity;
+	Request.Channel = Channel;
+	Request.QueryParams = QueryParams;
+	Request.ResponseParams = ResponseParams;
+
+	return AddRequest(MoveTemp(Request));
+}
+
+FAlsSceneQueryHandle UAlsSceneQuerySubsystem::RequestSweep(const EAlsSceneQuerySource Source, const FVector& Start, const FVector& End,
+                                                           const FQuat& Rotation, const ECollisionChannel Channel,
+                                                           const FCollisionShape& Shape, const FCollisionQueryParams& QueryParams,
+                                                           const FCollisionResponseParams& ResponseParams)
+{
+	FRequest Request;
+	Request.Source = Source;
+	Request.Start = Start;
+	Request.End = End;
+	Request.Rotation = Rotation;
+	Request.Shape = Shape;
+	Request.Channel = Channel;
+	Request.QueryParams = QueryParams;
+	Request.ResponseParams = ResponseParams;
+
+	return AddRequest(MoveTemp(Request));
+}
+
+EAlsSceneQueryStatus UAlsSceneQuerySubsystem::RetrieveResult(const FAlsSceneQueryHandle& Handle, FHitResult& Hit)
+{
+	if (!Handle.IsValid())
+	{
+		return EAlsSceneQueryStatus::Invalid;
+	}
+
+	FScopeLock Lock{&CriticalSection};
+
+	FResult Result;
+	if (Results.RemoveAndCopyValue(Handle.Id, Result))
+	{
+		Hit = MoveTemp(Result.Hit);
+		return EAlsSceneQueryStatus::Completed;
+	}
+
+	if (DispatchedHandleIds.Contains(Handle.Id) ||
+	    PendingRequests.ContainsByPredicate([&Handle](const FRequest& Request)
+	    {
+		    return Request.Handle.Id == Handle.Id;
+	    }))
+	{
+		return EAlsSceneQueryStatus::Pending;
+	}
+
+	return EAlsSceneQueryStatus::Invalid;
+}
+
+void UAlsSceneQuerySubsystem::Cancel(const FAlsSceneQueryHandle& Handle)
+{
+	if (!Handle.IsValid())
+	{
+		return;
+	}
+
+	FScopeLock Lock{&CriticalSection};
+
+	PendingRequests.RemoveAllSwap([&Handle](const FRequest& Request)
+	{
+		return Request.Handle.Id == Handle.Id;
+	});
+
+	DispatchedHandleIds.Remove(Handle.Id);
+	Results.Remove(Handle.Id);
+}
+
+bool UAlsSceneQuerySubsystem::LineTraceSingleByChannel(const UWorld* World, const EAlsSceneQuerySource Source, FHitResult& Hit,
+                                                       const FVector& Start, const FVector& End, const ECollisionChannel Channel,
+                                                       const FCollisionQueryParams& QueryParams,
+                                                       const FCollisionResponseParams& ResponseParams)
+{
+	const FAlsCostScope CostScope{FAlsCostScope::GetThreadCosts(), EAlsCostCategory::SceneQueries};
+
+	auto* Subsystem{Get(World)};
+	if (IsValid(Subsystem))
+	{
+		Subsystem->AddQueries(Source);
+	}
+
+	return World->LineTraceSingleByChannel(Hit, Start, End, Channel, QueryParams, ResponseParams);
+}
+
+bool UAlsSceneQuerySubsystem::SweepSingleByChannel(const UWorld* World, const EAlsSceneQuerySource Source, FHitResult& Hit,
+                                                   const FVector& Start, const FVector& End, const FQuat& Rotation,
+                                                   const ECollisionChannel Channel, const FCollisionShape& Shape,
+                                                   const FCollisionQueryParams& QueryParams,
+                                                   const FCollisionResponseParams& ResponseParams)
+{
+	const FAlsCostScope CostScope{FAlsCostScope::GetThreadCosts(), EAlsCostCategory::SceneQueries};
+
+	auto* Subsystem{Get(World)};
+	if (IsValid(Subsystem))
+	{
+		Subsystem->AddQueries(Source);
+	}
+
+	return World->SweepSingleByChannel(Hit, Start, End, Rotation, Channel, Shape, QueryParams, ResponseParams);
+}
+
+bool UAlsSceneQuerySubsystem::OverlapBlockingTestByChannel(const UWorld* World, const EAlsSceneQuerySource Source,
+                                                           const FVector& Location, const FQuat& Rotation,
+                                                           const ECollisionChannel Channel, const FCollisionShape& Shape,
+                                                           const FCollisionQueryParams& QueryParams,
+                                                           const FCollisionResponseParams& ResponseParams)
+{
+	const FAlsCostScope CostScope{FAlsCostScope::GetThreadCosts(), EAlsCostCategory::SceneQueries};
+
+	auto* Subsystem{Get(World)};
+	if (IsValid(Subsystem))
+	{
+		Subsystem->AddQueries(Source);
+	}
+
+	return World->OverlapBlockingTestByChannel(Location, Rotation, Channel, Shape, QueryParams, ResponseParams);
+}
+
+bool UAlsSceneQuerySubsystem::OverlapMultiByChannel(const UWorld* World, const EAlsSceneQuerySource Source,
+                                                    TArray<FOverlapResult>& Overlaps, const FVector& Location,
+                                                    const FQuat& Rotation, const ECollisionChannel Channel,
+                                                    const FCollisionShape& Shape, const FCollisionQueryParams& QueryParams,
+                                                    const FCollisionResponseParams& ResponseParams)
+{
+	const FAlsCostScope CostScope{FAlsCostScope::GetThreadCosts(), EAlsCostCategory::SceneQueries};
+
+	auto* Subsystem{Get(World)};
+	if (IsValid(Subsystem))
+	{
+		Subsystem->AddQueries(Source);
+	}
+
+	return World->OverlapMultiByChannel(Overlaps, Location, Rotation, Channel, Shape, QueryParams, ResponseParams);
+}
+
+FAlsSceneQueryHandle UAlsSceneQuerySubsystem::AddRequest(FRequest&& Request)
+{
+	FScopeLock Lock{&CriticalSection};
+
+	LastHandleId += 1;
+	if (LastHandleId == 0)
+	{
+		LastHandleId = 1;
+	}
+
+	Request.Handle.Id = LastHandleId;
+	Request.RequestFrame = GFrameCounter;
+
+	return PendingRequests.Emplace_GetRef(MoveTemp(Request)).Handle;
+}
+
+void UAlsSceneQuerySubsystem::DispatchRequests()
+{
+	check(IsInGameThread())
+
+	auto* World{GetWorld()};
+	if (!ALS_ENSURE(IsValid(World)))
+	{
+		return;
+	}
+
+	FScopeLock Lock{&CriticalSection};
+
+	if (PendingRequests.IsEmpty())
+	{
+		return;
+	}
+
+	// Dispatch the higher priority sources first, and the oldest requests first within the same priority,
+	// so that the requests deferred because of the budget are not starved by the newer ones.
+
+	PendingRequests.StableSort([this](const FRequest& A, const FRequest& B)
+	{
+		const auto PriorityA{GetSourcePriority(A.Source)};
+		const auto PriorityB{GetSourcePriority(B.Source)};
+
+		return PriorityA != PriorityB ? PriorityA > PriorityB : A.RequestFrame < B.RequestFrame;
+	});
+
+	// The dispatched traces run during the next frame, so they are checked against its budget rather than the current one.
+
+	const auto TotalBudget{GetTotalBudget()};
+
+	auto DispatchedQueriesCount{0};
+	auto DeferredRequestsCount{0};
+
+	for (auto i{0}; i < PendingRequests.Num(); i++)
+	{
+		auto& Request{PendingRequests[i]};
+		auto& SourceDispatchedQueriesCount{DispatchedQueriesCounts[static_cast<int32>(Request.Source)]};
+
+		const auto SourceBudget{GetSourceBudget(Request.Source)};
+
+		if ((SourceBudget > 0 && SourceDispatchedQueriesCount >= SourceBudget) ||
+		    (TotalBudget > 0 && DispatchedQueriesCount >= TotalBudget))
+		{
+			// Move the deferred requests to the beginning of the array, keeping their order.
+
+			if (DeferredRequestsCount != i)
+			{
+				PendingRequests[DeferredRequestsCount] = MoveTemp(Request);
+			}
+
+			DeferredRequestsCount += 1;
+			continue;
+		}
+
+		if (Request.Shape.IsLine())
+		{
+			World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Request.Start, Request.End, Request.Channel,
+			                               Request.QueryParams, Request.ResponseParams, &TraceDelegate, Request.Handle.Id);
+		}
+		else
+		{
+			World->AsyncSweepByChannel(EAsyncTraceType::Single, Request.Start, Request.End, Request.Rotation, Request.Channel,
+			                           Request.Shape, Request.QueryParams, Request.ResponseParams, &TraceDelegate, Request.Handle.Id);
+		}
+
+		DispatchedHandleIds.Add(Request.Handle.Id);
+
+		SourceDispatchedQueriesCount += 1;
+		DispatchedQueriesCount += 1;
+	}
+
+	PendingRequests.SetNum(DeferredRequestsCount, EAllowShrinking::No);
+}
+
+void UAlsSceneQuerySubsystem::OnTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	FScopeLock Lock{&CriticalSection};
+
+	if (DispatchedHandleIds.Remove(TraceDatum.UserData) <= 0)
+	{
+		// The query was canceled.
+		return;
+	}
+
+	auto& Result{Results.Add(TraceDatum.UserData)};
+	Result.CompleteFrame = GFrameCounter;
+
+	if (TraceDatum.OutHits.IsEmpty())
+	{
+		Result.Hit = FHitResult{TraceDatum.Start, TraceDatum.End};
+	}
+	else
+	{
+		Result.Hit = MoveTemp(TraceDatum.OutHits[0]);
+	}
+}
@@ -1,7 +1,9 @@
 #include "Nodes/AlsRigUnit_FootOffsetTrace.h"
 
+#include "AlsSceneQuerySubsystem.h"
 #include "Engine/HitResult.h"
 #include "Engine/World.h"
+#include "Utility/AlsUtility.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsRigUnit_FootOffsetTrace)
 
@@ -22,8 +24,11 @@ FAlsRigUnit_FootOffsetTrace_Execute()
 	const FVector TraceEnd{FootTargetLocation.X, FootTargetLocation.Y, -TraceDistanceDownward};
 
 	FHitResult Hit;
-	ExecuteContext.GetWorld()->LineTraceSingleByChannel(Hit, ExecuteContext.ToWorldSpace(TraceStart), ExecuteContext.ToWorldSpace(TraceEnd),
-	                                                    TraceChannel, {__FUNCTION__, true, ExecuteContext.GetOwningActor()});
+	UAlsSceneQuerySubsystem::LineTraceSingleByChannel(ExecuteContext.GetWorld(), EAlsSceneQuerySource::FootIk, Hit,
+	                                                  ExecuteContext.ToWorldSpace(TraceStart), ExecuteContext.ToWorldSpace(TraceEnd),
+	                                                  TraceChannel, {__FUNCTION__, true, ExecuteContext.GetOwningActor()});
+
+	CSV_CUSTOM_STAT(Als, FootIkQueries, 1, ECsvCustomStatOp::Accumulate);
 
 	auto* DrawInterface{ExecuteContext.GetDrawInterface()};
 	if (DrawInterface != nullptr && bDrawDebug)
@@ -29,33 +29,148 @@ bool UAlsAnimNotifyState_EarlyBlendOut::CanBePlaced(UAnimSequenceBase* Sequence)
 }
 #endif
 
-void UAlsAnimNotifyState_EarlyBlendOut::BranchingPointNotifyTick(FBranchingPointNotifyPayload& NotifyPayload, const float DeltaTime)
+void UAlsAnimNotifyState_EarlyBlendOut::BranchingPointNotifyBegin(FBranchingPointNotifyPayload& NotifyPayload)
 {
-	Super::BranchingPointNotifyTick(NotifyPayload, DeltaTime);
+	Super::BranchingPointNotifyBegin(NotifyPayload);
+
+	check(IsInGameThread())
 
 	const auto* Mesh{NotifyPayload.SkelMeshComponent};
 	auto* AnimationInstance{IsValid(Mesh) ? Mesh->GetAnimInstance() : nullptr};
-	const auto* Character{IsValid(AnimationInstance) ? Cast<AAlsCharacter>(Mesh->GetOwner()) : nullptr};
+	auto* Character{IsValid(AnimationInstance) ? Cast<AAlsCharacter>(Mesh->GetOwner()) : nullptr};
+
+	RemoveInvalidInstances();
+
+	if (!IsValid(Character))
+	{
+		return;
+	}
+
+	const FInstanceKey InstanceKey{AnimationInstance, NotifyPayload.MontageInstanceID};
 
-	if (IsValid(Character) &&
-	    ((bCheckInput && Character->GetLocomotionState().bHasInput) ||
-	     (bCheckLocomotionMode && Character->GetLocomotionMode() == LocomotionModeEquals) ||
-	     (bCheckRotationMode && Character->GetRotationMode() == RotationModeEquals) ||
-	     (bCheckStance && Character->GetStance() == StanceEquals)))
+	auto& Instance{Instances.Emplace(InstanceKey, FInstance{Character, AnimationInstance})};
+
+	if (IsBlendOutRequired(*Character))
 	{
-		auto* MontageInstance{AnimationInstance->GetMontageInstanceForID(NotifyPayload.MontageInstanceID)};
-		if (!ALS_ENSURE(MontageInstance != nullptr))
+		StopMontage(InstanceKey);
+		return;
+	}
+
+	// Instead of checking the conditions every tick, check them only when the character state changes.
+
+	Instance.StateChangedHandle = Character->OnStateChanged.AddUObject(this, &ThisClass::Character_OnStateChanged, InstanceKey);
+}
+
+void UAlsAnimNotifyState_EarlyBlendOut::BranchingPointNotifyEnd(FBranchingPointNotifyPayload& NotifyPayload)
+{
+	Super::BranchingPointNotifyEnd(NotifyPayload);
+
+	check(IsInGameThread())
+
+	RemoveInvalidInstances();
+
+	const auto* Mesh{NotifyPayload.SkelMeshComponent};
+	const auto* AnimationInstance{IsValid(Mesh) ? Mesh->GetAnimInstance() : nullptr};
+
+	FInstance Instance;
+	if (!Instances.RemoveAndCopyValue(FInstanceKey{AnimationInstance, NotifyPayload.MontageInstanceID}, Instance))
+	{
+		return;
+	}
+
+	auto* Character{Instance.Character.Get()};
+	if (IsValid(Character))
+	{
+		Character->OnStateChanged.Remove(Instance.StateChangedHandle);
+	}
+}
+
+void UAlsAnimNotifyState_EarlyBlendOut::RemoveInvalidInstances()
+{
+	// Remove the instances that were not ended properly, for example, because their character was destroyed.
+
+	for (auto Iterator{Instances.CreateIterator()}; Iterator; ++Iterator)
+	{
+		if (!Iterator.Value().Character.IsValid() || !Iterator.Value().AnimationInstance.IsValid())
 		{
-			return;
+			Iterator.RemoveCurrent();
 		}
+	}
+}
+
+bool UAlsAnimNotifyState_EarlyBlendOut::IsBlendOutRequired(const AAlsCharacter& Character) const
+{
+	return (bCheckInput && Character.GetLocomotionState().bHasInput) ||
+	       (bCheckLocomotionMode && Character.GetLocomotionMode() == LocomotionModeEquals) ||
+	       (bCheckRotationMode && Character.GetRotationMode() == RotationModeEquals) ||
+	       (bCheckStance && Character.GetStance() == StanceEquals);
+}
+
+void UAlsAnimNotifyState_EarlyBlendOut::StopMontage(const FInstanceKey& InstanceKey)
+{
+	auto* Instance{Instances.Find(InstanceKey)};
+	if (Instance == nullptr)
+	{
+		return;
+	}
+
+	auto* Character{Instance->Character.Get()};
+	if (IsValid(Character))
+	{
+		// The montage is already blending out, so there is no need to react to further state changes.
+
+		Character->OnStateChanged.Remove(Instance->StateChangedHandle);
+		Instance->StateChangedHandle.Reset();
+	}
+
+	auto* AnimationInstance{Instance->AnimationInstance.Get()};
+	auto* MontageInstance{IsValid(AnimationInstance) ? AnimationInstance->GetMontageInstanceForID(InstanceKey.Get<1>()) : nullptr};
+
+	if (MontageInstance == nullptr || !IsValid(MontageInstance->Montage))
+	{
+		return;
+	}
+
+	const auto* Montage{MontageInstance->Montage.Get()};
+
+	FMontageBlendSettings BlendOutSettings{Montage->BlendOut};
+	BlendOutSettings.Blend.BlendTime = BlendOutDuration;
+	BlendOutSettings.BlendMode = Montage->BlendModeOut;
+	BlendOutSettings.BlendProfile = Montage->BlendProfileOut;
+
+	MontageInstance->Stop(BlendOutSettings);
+}
+
+void UAlsAnimNotifyState_EarlyBlendOut::Character_OnStateChanged(AAlsCharacter* Character, const EAlsCharacterStateChange Change,
+                                                                 const FInstanceKey InstanceKey)
+{
+	bool bRelevantChange;
+
+	switch (Change)
+	{
+		case EAlsCharacterStateChange::InputStarted:
+			bRelevantChange = bCheckInput;
+			break;
+
+		case EAlsCharacterStateChange::LocomotionMode:
+			bRelevantChange = bCheckLocomotionMode;
+			break;
 
-		const auto* Montage{MontageInstance->Montage.Get()};
+		case EAlsCharacterStateChange::RotationMode:
+			bRelevantChange = bCheckRotationMode;
+			break;
 
-		FMontageBlendSettings BlendOutSettings{Montage->BlendOut};
-		BlendOutSettings.Blend.BlendTime = BlendOutDuration;
-		BlendOutSettings.BlendMode = Montage->BlendModeOut;
-		BlendOutSettings.BlendProfile = Montage->BlendProfileOut;
+		case EAlsCharacterStateChange::Stance:
+			bRelevantChange = bCheckStance;
+			break;
 
-		MontageInstance->Stop(BlendOutSettings);
+		default:
+			bRelevantChange = false;
+			break;
+	}
+
+	if (bRelevantChange && IsValid(Character) && IsBlendOutRequired(*Character))
+	{
+		StopMontage(InstanceKey);
 	}
 }
@@ -1,6 +1,7 @@
 #include "Notifies/AlsAnimNotify_FootstepEffects.h"
 
 #include "AlsCharacter.h"
+#include "AlsSceneQuerySubsystem.h"
 #include "DrawDebugHelpers.h"
 #include "NiagaraFunctionLibrary.h"
 #include "Animation/AnimInstance.h"
@@ -16,6 +17,7 @@
 #include "Utility/AlsEnumUtility.h"
 #include "Utility/AlsMacros.h"
 #include "Utility/AlsMath.h"
+#include "Utility/AlsUtility.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsAnimNotify_FootstepEffects)
 
@@ -105,34 +107,58 @@ void UAlsAnimNotify_FootstepEffects::Notify(USkeletalMeshComponent* Mesh, UAnimS
 			                                     : FVector{FootstepEffectsSettings->FootRightZAxis})
 	};
 
-	FCollisionQueryParams QueryParameters{__FUNCTION__, true, Mesh->GetOwner()};
-	QueryParameters.bReturnPhysicalMaterial = true;
+	// If the scene query budget is exceeded, skip the surface traces and spawn the
+	// effects of the default surface at the foot location, but without a decal.
+
+	const auto bSurfaceTraceSkipped{UAlsSceneQuerySubsystem::IsBudgetExceeded(World, EAlsSceneQuerySource::Footsteps)};
 
 	FHitResult FootstepHit;
-	if (!World->LineTraceSingleByChannel(FootstepHit, FootTransform.GetLocation(),
-	                                     FootTransform.GetLocation() - FootZAxis *
-	                                     (FootstepEffectsSettings->SurfaceTraceDistance * MeshScale),
-	                                     FootstepEffectsSettings->SurfaceTraceChannel, QueryParameters))
-	{
-		// As a fallback, trace down the world Z axis if the first trace didn't hit anything.
 
-		World->LineTraceSingleByChannel(FootstepHit, FootTransform.GetLocation(),
-		                                FootTransform.GetLocation() - FVector{
-			                                0.0f, 0.0f, FootstepEffectsSettings->SurfaceTraceDistance * MeshScale
-		                                }, FootstepEffectsSettings->SurfaceTraceChannel, QueryParameters);
+	if (bSurfaceTraceSkipped)
+	{
+		FootstepHit = FHitResult{FootTransform.GetLocation(), FootTransform.GetLocation()};
+		FootstepHit.bBlockingHit = true;
+		FootstepHit.Location = FootTransform.GetLocation();
+		FootstepHit.ImpactPoint = FootTransform.GetLocation();
+		FootstepHit.Normal = FVector::ZAxisVector;
+		FootstepHit.ImpactNormal = FVector::ZAxisVector;
+
+		CSV_CUSTOM_STAT(Als, DegradedQueries, 1, ECsvCustomStatOp::Accumulate);
 	}
+	else
+	{
+		FCollisionQueryParams QueryParameters{__FUNCTION__, true, Mesh->GetOwner()};
+		QueryParameters.bReturnPhysicalMaterial = true;
+
+		CSV_CUSTOM_STAT(Als, FootstepQueries, 1, ECsvCustomStatOp::Accumulate);
+
+		if (!UAlsSceneQuerySubsystem::LineTraceSingleByChannel(World, EAlsSceneQuerySource::Footsteps, FootstepHit,
+		                                                       FootTransform.GetLocation(), FootTransform.GetLocation() - FootZAxis *
+		                                                       (FootstepEffectsSettings->SurfaceTraceDistance * MeshScale),
+		                                                       FootstepEffectsSettings->SurfaceTraceChannel, QueryParameters))
+		{
+			// As a fallback, trace down the world Z axis if the first trace didn't hit anything.
+
+			CSV_CUSTOM_STAT(Als, FootstepQueries, 1, ECsvCustomStatOp::Accumulate);
+
+			UAlsSceneQuerySubsystem::LineTraceSingleByChannel(World, EAlsSceneQuerySource::Footsteps, FootstepHit,
+			                                                  FootTransform.GetLocation(), FootTransform.GetLocation() - FVector{
+				                                                  0.0f, 0.0f, FootstepEffectsSettings->SurfaceTraceDistance * MeshScale
+			                                                  }, FootstepEffectsSettings->SurfaceTraceChannel, QueryParameters);
+		}
 
 #if ENABLE_DRAW_DEBUG
-	if (bDisplayDebug)
-	{
-		UAlsDebugUtility::DrawLineTraceSingle(World, FootstepHit.TraceStart, FootstepHit.TraceEnd, FootstepHit.bBlockingHit,
-		                                      FootstepHit, {0.333333f, 0.0f, 0.0f}, FLinearColor::Red, 10.0f);
-	}
+		if (bDisplayDebug)
+		{
+			UAlsDebugUtility::DrawLineTraceSingle(World, FootstepHit.TraceStart, FootstepHit.TraceEnd, FootstepHit.bBlockingHit,
+			                                      FootstepHit, {0.333333f, 0.0f, 0.0f}, FLinearColor::Red, 10.0f);
+		}
 #endif
 
-	if (!FootstepHit.bBlockingHit)
-	{
-		return;
+		if (!FootstepHit.bBlockingHit)
+		{
+			return;
+		}
 	}
 
 	const auto SurfaceType{FootstepHit.PhysMaterial.IsValid() ? FootstepHit.PhysMaterial->SurfaceType.GetValue() : SurfaceType_Default};
@@ -174,7 +200,7 @@ void UAlsAnimNotify_FootstepEffects::Notify(USkeletalMeshComponent* Mesh, UAnimS
 		SpawnSound(Mesh, EffectSettings->Sound, FootstepLocation, FootstepRotation);
 	}
 
-	if (bSpawnDecal)
+	if (bSpawnDecal && !bSurfaceTraceSkipped)
 	{
 		SpawnDecal(Mesh, EffectSettings->Decal, FootstepLocation, FootstepRotation, FootstepHit, FootZAxis);
 	}
@@ -1,5 +1,8 @@
 ﻿#include "Settings/AlsAnimationInstanceSettings.h"
 
+#include "Animation/AnimSequenceBase.h"
+#include "Utility/AlsConstants.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsAnimationInstanceSettings)
 
 UAlsAnimationInstanceSettings::UAlsAnimationInstanceSettings()
@@ -16,9 +19,23 @@ UAlsAnimationInstanceSettings::UAlsAnimationInstanceSettings()
 	InAir.GroundPredictionSweepResponses.Destructible = ECR_Block;
 }
 
+void UAlsAnimationInstanceSettings::PostLoad()
+{
+	Super::PostLoad();
+
+	PreloadSequences();
+
+	if (IsInGameThread() && !HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+	{
+		PrebuildDynamicMontages();
+	}
+}
+
 #if WITH_EDITOR
 void UAlsAnimationInstanceSettings::PostEditChangeProperty(FPropertyChangedEvent& ChangedEvent)
 {
+	DynamicMontages.Reset();
+
 	if (ChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_STRING_VIEW_CHECKED(ThisClass, InAir))
 	{
 		InAir.PostEditChangeProperty(ChangedEvent);
@@ -27,3 +44,87 @@ void UAlsAnimationInstanceSettings::PostEditChangeProperty(FPropertyChangedEvent
 	Super::PostEditChangeProperty(ChangedEvent);
 }
 #endif
+
+void UAlsAnimationInstanceSettings::PreloadSequences() const
+{
+	// Make sure that all referenced animation sequences are fully loaded along with the settings
+	// so that the first transition or turn in place during gameplay does not cause a hitch.
+
+	for (auto* Sequence : {
+		     Transitions.StandingLeftSequence.Get(), Transitions.StandingRightSequence.Get(),
+		     Transitions.CrouchingLeftSequence.Get(), Transitions.CrouchingRightSequence.Get(),
+		     DynamicTransitions.StandingLeftSequence.Get(), DynamicTransitions.StandingRightSequence.Get(),
+		     DynamicTransitions.CrouchingLeftSequence.Get(), DynamicTransitions.CrouchingRightSequence.Get()
+	     })
+	{
+		if (IsValid(Sequence))
+		{
+			Sequence->ConditionalPostLoad();
+		}
+	}
+
+	for (auto* TurnInPlaceSettings : {
+		     TurnInPlace.StandingTurn90Left.Get(), TurnInPlace.StandingTurn90Right.Get(),
+		     TurnInPlace.StandingTurn180Left.Get(), TurnInPlace.StandingTurn180Right.Get(),
+		     TurnInPlace.CrouchingTurn90Left.Get(), TurnInPlace.CrouchingTurn90Right.Get(),
+		     TurnInPlace.CrouchingTurn180Left.Get(), TurnInPlace.CrouchingTurn180Right.Get()
+	     })
+	{
+		if (IsValid(TurnInPlaceSettings))
+		{
+			TurnInPlaceSettings->ConditionalPostLoad();
+
+			if (IsValid(TurnInPlaceSettings->Sequence))
+			{
+				TurnInPlaceSettings->Sequence->ConditionalPostLoad();
+			}
+		}
+	}
+}
+
+void UAlsAnimationInstanceSettings::PrebuildDynamicMontages()
+{
+	check(IsInGameThread())
+
+	for (auto* Sequence : {
+		     Transitions.StandingLeftSequence.Get(), Transitions.StandingRightSequence.Get(),
+		     Transitions.CrouchingLeftSequence.Get(), Transitions.CrouchingRightSequence.Get()
+	     })
+	{
+		DynamicMontages.FindOrCreate(Sequence, UAlsConstants::TransitionSlotName(),
+		                             Transitions.QuickStopBlendInDuration, Transitions.QuickStopBlendOutDuration);
+	}
+
+	for (auto* Sequence : {
+		     DynamicTransitions.StandingLeftSequence.Get(), DynamicTransitions.StandingRightSequence.Get(),
+		     DynamicTransitions.CrouchingLeftSequence.Get(), DynamicTransitions.CrouchingRightSequence.Get()
+	     })
+	{
+		DynamicMontages.FindOrCreate(Sequence, UAlsConstants::TransitionSlotName(),
+		                             DynamicTransitions.BlendDuration, DynamicTransitions.BlendDuration);
+	}
+
+	for (const auto* TurnInPlaceSettings : {
+		     TurnInPlace.StandingTurn90Left.Get(), TurnInPlace.StandingTurn90Right.Get(),
+		     TurnInPlace.StandingTurn180Left.Get(), TurnInPlace.StandingTurn180Right.Get()
+	     })
+	{
+		if (IsValid(TurnInPlaceSettings))
+		{
+			DynamicMontages.FindOrCreate(TurnInPlaceSettings->Sequence, UAlsConstants::TurnInPlaceStandingSlotName(),
+			                             TurnInPlace.BlendDuration, TurnInPlace.BlendDuration);
+		}
+	}
+
+	for (const auto* TurnInPlaceSettings : {
+		     TurnInPlace.CrouchingTurn90Left.Get(), TurnInPlace.CrouchingTurn90Right.Get(),
+		     TurnInPlace.CrouchingTurn180Left.Get(), TurnInPlace.CrouchingTurn180Right.Get()
+	     })
+	{
+		if (IsValid(TurnInPlaceSettings))
+		{
+			DynamicMontages.FindOrCreate(TurnInPlaceSettings->Sequence, UAlsConstants::TurnInPlaceCrouchingSlotName(),
+			                             TurnInPlace.BlendDuration, TurnInPlace.BlendDuration);
+		}
+	}
+}
@@ -0,0 +1,63 @@
+#include "Settings/AlsDynamicMontageCache.h"
+
+#include "Animation/AnimMontage.h"
+#include "Animation/AnimSequenceBase.h"
+#include "Utility/AlsUtility.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsDynamicMontageCache)
+
+UAnimMontage* FAlsDynamicMontageCache::FindOrCreate(UAnimSequenceBase* Sequence, const FName& SlotName,
+                                                    const float BlendInDuration, const float BlendOutDuration)
+{
+	check(IsInGameThread())
+
+	if (!IsValid(Sequence))
+	{
+		return nullptr;
+	}
+
+	FAlsDynamicMontageKey Key;
+	Key.Sequence = Sequence;
+	Key.SlotName = SlotName;
+	Key.BlendInDuration = BlendInDuration;
+	Key.BlendOutDuration = BlendOutDuration;
+
+	auto* CachedMontage{Montages.Find(Key)};
+	if (CachedMontage != nullptr && IsValid(*CachedMontage))
+	{
+		return *CachedMontage;
+	}
+
+	// The play rate is not baked into the montage and is instead passed to UAnimInstance::Montage_Play(),
+	// so the same montage can be shared between all play rates and start times of the same sequence.
+
+	const FMontageBlendSettings BlendInSettings{BlendInDuration};
+	const FMontageBlendSettings BlendOutSettings{BlendOutDuration};
+
+	auto* Montage{
+		UAnimMontage::CreateSlotAnimationAsDynamicMontage_WithBlendSettings(Sequence, SlotName, BlendInSettings,
+		                                                                    BlendOutSettings, 1.0f, 1, 0.0f)
+	};
+
+	CSV_CUSTOM_STAT(Als, MontagesCreated, 1, ECsvCustomStatOp::Accumulate);
+
+	// The blend durations can come from blueprints, so once the cache is full, montages for new combinations are
+	// no longer cached, otherwise arbitrary durations would grow it indefinitely. The combinations from the settings
+	// are prebuilt when the settings are loaded, so they are always cached.
+
+	if (CachedMontage != nullptr)
+	{
+		*CachedMontage = Montage;
+	}
+	else if (Montages.Num() < MaxMontagesCount)
+	{
+		Montages.Emplace(Key, Montage);
+	}
+
+	return Montage;
+}
+
+void FAlsDynamicMontageCache::Reset()
+{
+	Montages.Reset();
+}
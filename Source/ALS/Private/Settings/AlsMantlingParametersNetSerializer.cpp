@@ -0,0 +1,384 @@
+#include "Settings/AlsMantlingParametersNetSerializer.h"
+
+#include "Settings/AlsMantlingSettings.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsMantlingParametersNetSerializer)
+
+#if UE_WITH_IRIS
+
+#include "Iris/Core/NetObjectReference.h"
+#include "Iris/ReplicationState/PropertyNetSerializerInfoRegistry.h"
+#include "Iris/Serialization/BitPacking.h"
+#include "Iris/Serialization/NetBitStreamReader.h"
+#include "Iris/Serialization/NetBitStreamWriter.h"
+#include "Iris/Serialization/NetSerializerDelegates.h"
+#include "Iris/Serialization/ObjectNetSerializer.h"
+
+namespace UE::Net
+{
+	struct FAlsMantlingParametersNetSerializer
+	{
+		static constexpr uint32 Version{0};
+
+		static constexpr bool bHasCustomNetReference{true};
+
+		struct FQuantizedType
+		{
+			FNetObjectReference TargetPrimitive;
+
+			int32 TargetRelativeLocation[3];
+
+			uint16 TargetRelativeRotation[3];
+
+			int32 MantlingHeight;
+
+			uint8 MantlingType;
+		};
+
+		using SourceType = FAlsMantlingParameters;
+		using QuantizedType = FQuantizedType;
+		using ConfigType = FAlsMantlingParametersNetSerializerConfig;
+
+		static const ConfigType DefaultConfig;
+
+		static void Serialize(FNetSerializationContext& Context, const FNetSerializeArgs& Args);
+
+		static void Deserialize(FNetSerializationContext& Context, const FNetDeserializeArgs& Args);
+
+		static void SerializeDelta(FNetSerializationContext& Context, const FNetSerializeDeltaArgs& Args);
+
+		static void DeserializeDelta(FNetSerializationContext& Context, const FNetDeserializeDeltaArgs& Args);
+
+		static void Quantize(FNetSerializationContext& Context, const FNetQuantizeArgs& Args);
+
+		static void Dequantize(FNetSerializationContext& Context, const FNetDequantizeArgs& Args);
+
+		static bool IsEqual(FNetSerializationContext& Context, const FNetIsEqualArgs& Args);
+
+		static bool Validate(FNetSerializationContext& Context, const FNetValidateArgs& Args);
+
+		static void CollectNetReferences(FNetSerializationContext& Context, const FNetCollectReferencesArgs& Args);
+
+	private:
+		static constexpr auto LocationScale{100.0f};
+
+		// Limits the quantized values so that the difference between any two of them fits into 32 bits.
+		static constexpr auto MaxQuantizedLocation{(1 << 30) - 1};
+
+		static constexpr auto MantlingTypeBitsCount{2};
+
+		static_assert(static_cast<uint8>(EAlsMantlingType::InAir) < 1 << MantlingTypeBitsCount);
+
+		class FNetSerializerRegistryDelegates final : private UE::Net::FNetSerializerRegistryDelegates
+		{
+		public:
+			virtual ~FNetSerializerRegistryDelegates() override;
+
+		private:
+			virtual void OnPreFreezeNetSerializerRegistry() override;
+
+			virtual void OnPostFreezeNetSerializerRegistry() override;
+		};
+
+		static FNetSerializerRegistryDelegates NetSerializerRegistryDelegates;
+
+		static const FNetSerializer* ObjectNetSerializer;
+
+		static const FNetSerializerConfig* ObjectNetSerializerConfig;
+
+		static int32 QuantizeLocation(float Value);
+
+		static void WriteRotationAxis(FNetBitStreamWriter& Writer, uint16 Value);
+
+		static uint16 ReadRotationAxis(FNetBitStreamReader& Reader);
+
+		static uint8 ReadMantlingType(FNetBitStreamReader& Reader);
+	};
+
+	UE_NET_IMPLEMENT_SERIALIZER(FAlsMantlingParametersNetSerializer);
+
+	const FAlsMantlingParametersNetSerializer::ConfigType FAlsMantlingParametersNetSerializer::DefaultConfig;
+
+	FAlsMantlingParametersNetSerializer::FNetSerializerRegistryDelegates
+	FAlsMantlingParametersNetSerializer::NetSerializerRegistryDelegates;
+
+	const FNetSerializer* FAlsMantlingParametersNetSerializer::ObjectNetSerializer{&UE_NET_GET_SERIALIZER(FWeakObjectNetSerializer)};
+
+	const FNetSerializerConfig* FAlsMantlingParametersNetSerializer::ObjectNetSerializerConfig{
+		UE_NET_GET_SERIALIZER_DEFAULT_CONFIG(FWeakObjectNetSerializer)
+	};
+
+	static const FName PropertyNetSerializerRegistry_NAME_AlsMantlingParameters{TEXTVIEW("AlsMantlingParameters")};
+	UE_NET_IMPLEMENT_NAMED_STRUCT_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_AlsMantlingParameters,
+	                                                 FAlsMantlingParametersNetSerializer);
+
+	FAlsMantlingParametersNetSerializer::FNetSerializerRegistryDelegates::~FNetSerializerRegistryDelegates()
+	{
+		UE_NET_UNREGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_AlsMantlingParameters);
+	}
+
+	void FAlsMantlingParametersNetSerializer::FNetSerializerRegistryDelegates::OnPreFreezeNetSerializerRegistry()
+	{
+		UE_NET_REGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_AlsMantlingParameters);
+	}
+
+	void FAlsMantlingParametersNetSerializer::FNetSerializerRegistryDelegates::OnPostFreezeNetSerializerRegistry()
+	{
+		// The target primitive is stored in the quantized state of the weak object net serializer.
+
+		check(ObjectNetSerializer->QuantizedTypeSize == sizeof(FNetObjectReference))
+		check(ObjectNetSerializer->QuantizedTypeAlignment <= alignof(FNetObjectReference))
+	}
+
+	int32 FAlsMantlingParametersNetSerializer::QuantizeLocation(const float Value)
+	{
+		return FMath::Clamp(FMath::RoundToInt32(Value * LocationScale), -MaxQuantizedLocation, MaxQuantizedLocation);
+	}
+
+	void FAlsMantlingParametersNetSerializer::WriteRotationAxis(FNetBitStreamWriter& Writer, const uint16 Value)
+	{
+		// Pitch and roll are almost always zero, so only send a single bit for them in that case.
+
+		Writer.WriteBool(Value != 0);
+
+		if (Value != 0)
+		{
+			Writer.WriteBits(Value, 16);
+		}
+	}
+
+	uint16 FAlsMantlingParametersNetSerializer::ReadRotationAxis(FNetBitStreamReader& Reader)
+	{
+		return Reader.ReadBool() ? static_cast<uint16>(Reader.ReadBits(16)) : 0;
+	}
+
+	uint8 FAlsMantlingParametersNetSerializer::ReadMantlingType(FNetBitStreamReader& Reader)
+	{
+		// The mantling parameters are also received from clients, so clamp values outside
+		// of the enumeration, which can only come from a malformed or malicious packet.
+
+		return FMath::Min(static_cast<uint8>(Reader.ReadBits(MantlingTypeBitsCount)), static_cast<uint8>(EAlsMantlingType::InAir));
+	}
+
+	void FAlsMantlingParametersNetSerializer::Serialize(FNetSerializationContext& Context, const FNetSerializeArgs& Args)
+	{
+		const auto& Value{*reinterpret_cast<const QuantizedType*>(Args.Source)};
+		auto& Writer{*Context.GetBitStreamWriter()};
+
+		auto ObjectArgs{Args};
+		ObjectArgs.NetSerializerConfig = NetSerializerConfigParam{ObjectNetSerializerConfig};
+		ObjectArgs.Source = NetSerializerValuePointer(&Value.TargetPrimitive);
+
+		ObjectNetSerializer->Serialize(Context, ObjectArgs);
+
+		for (const auto Location : Value.TargetRelativeLocation)
+		{
+			WritePackedInt32(&Writer, Location);
+		}
+
+		for (const auto Rotation : Value.TargetRelativeRotation)
+		{
+			WriteRotationAxis(Writer, Rotation);
+		}
+
+		WritePackedInt32(&Writer, Value.MantlingHeight);
+
+		Writer.WriteBits(Value.MantlingType, MantlingTypeBitsCount);
+	}
+
+	void FAlsMantlingParametersNetSerializer::Deserialize(FNetSerializationContext& Context, const FNetDeserializeArgs& Args)
+	{
+		auto& Target{*reinterpret_cast<QuantizedType*>(Args.Target)};
+		auto& Reader{*Context.GetBitStreamReader()};
+
+		auto ObjectArgs{Args};
+		ObjectArgs.NetSerializerConfig = NetSerializerConfigParam{ObjectNetSerializerConfig};
+		ObjectArgs.Target = NetSerializerValuePointer(&Target.TargetPrimitive);
+
+		ObjectNetSerializer->Deserialize(Context, ObjectArgs);
+
+		for (auto& Location : Target.TargetRelativeLocation)
+		{
+			Location = ReadPackedInt32(&Reader);
+		}
+
+		for (auto& Rotation : Target.TargetRelativeRotation)
+		{
+			Rotation = ReadRotationAxis(Reader);
+		}
+
+		Target.MantlingHeight = ReadPackedInt32(&Reader);
+
+		Target.MantlingType = ReadMantlingType(Reader);
+	}
+
+	void FAlsMantlingParametersNetSerializer::SerializeDelta(FNetSerializationContext& Context, const FNetSerializeDeltaArgs& Args)
+	{
+		const auto& Value{*reinterpret_cast<const QuantizedType*>(Args.Source)};
+		const auto& PreviousValue{*reinterpret_cast<const QuantizedType*>(Args.Prev)};
+		auto& Writer{*Context.GetBitStreamWriter()};
+
+		auto ObjectArgs{Args};
+		ObjectArgs.NetSerializerConfig = NetSerializerConfigParam{ObjectNetSerializerConfig};
+		ObjectArgs.Source = NetSerializerValuePointer(&Value.TargetPrimitive);
+		ObjectArgs.Prev = NetSerializerValuePointer(&PreviousValue.TargetPrimitive);
+
+		ObjectNetSerializer->SerializeDelta(Context, ObjectArgs);
+
+		// The character usually mantles onto the same target several times in a row, so the location is sent as
+		// a difference from the previous one, and the rest of the members are only sent when they have changed.
+
+		for (auto i{0}; i < 3; i++)
+		{
+			WritePackedInt32(&Writer, Value.TargetRelativeLocation[i] - PreviousValue.TargetRelativeLocation[i]);
+		}
+
+		for (auto i{0}; i < 3; i++)
+		{
+			Writer.WriteBool(Value.TargetRelativeRotation[i] != PreviousValue.TargetRelativeRotation[i]);
+
+			if (Value.TargetRelativeRotation[i] != PreviousValue.TargetRelativeRotation[i])
+			{
+				Writer.WriteBits(Value.TargetRelativeRotation[i], 16);
+			}
+		}
+
+		WritePackedInt32(&Writer, Value.MantlingHeight - PreviousValue.MantlingHeight);
+
+		Writer.WriteBool(Value.MantlingType != PreviousValue.MantlingType);
+
+		if (Value.MantlingType != PreviousValue.MantlingType)
+		{
+			Writer.WriteBits(Value.MantlingType, MantlingTypeBitsCount);
+		}
+	}
+
+	void FAlsMantlingParametersNetSerializer::DeserializeDelta(FNetSerializationContext& Context, const FNetDeserializeDeltaArgs& Args)
+	{
+		auto& Target{*reinterpret_cast<QuantizedType*>(Args.Target)};
+		const auto& PreviousValue{*reinterpret_cast<const QuantizedType*>(Args.Prev)};
+		auto& Reader{*Context.GetBitStreamReader()};
+
+		auto ObjectArgs{Args};
+		ObjectArgs.NetSerializerConfig = NetSerializerConfigParam{ObjectNetSerializerConfig};
+		ObjectArgs.Target = NetSerializerValuePointer(&Target.TargetPrimitive);
+		ObjectArgs.Prev = NetSerializerValuePointer(&PreviousValue.TargetPrimitive);
+
+		ObjectNetSerializer->DeserializeDelta(Context, ObjectArgs);
+
+		for (auto i{0}; i < 3; i++)
+		{
+			Target.TargetRelativeLocation[i] = PreviousValue.TargetRelativeLocation[i] + ReadPackedInt32(&Reader);
+		}
+
+		for (auto i{0}; i < 3; i++)
+		{
+			Target.TargetRelativeRotation[i] = Reader.ReadBool()
+				                                   ? static_cast<uint16>(Reader.ReadBits(16))
+				                                   : PreviousValue.TargetRelativeRotation[i];
+		}
+
+		Target.MantlingHeight = PreviousValue.MantlingHeight + ReadPackedInt32(&Reader);
+
+		Target.MantlingType = Reader.ReadBool() ? ReadMantlingType(Reader) : PreviousValue.MantlingType;
+	}
+
+	void FAlsMantlingParametersNetSerializer::Quantize(FNetSerializationContext& Context, const FNetQuantizeArgs& Args)
+	{
+		const auto& Source{*reinterpret_cast<const SourceType*>(Args.Source)};
+		auto& Target{*reinterpret_cast<QuantizedType*>(Args.Target)};
+
+		auto ObjectArgs{Args};
+		ObjectArgs.NetSerializerConfig = NetSerializerConfigParam{ObjectNetSerializerConfig};
+		ObjectArgs.Source = NetSerializerValuePointer(&Source.TargetPrimitive);
+		ObjectArgs.Target = NetSerializerValuePointer(&Target.TargetPrimitive);
+
+		ObjectNetSerializer->Quantize(Context, ObjectArgs);
+
+		Target.TargetRelativeLocation[0] = QuantizeLocation(UE_REAL_TO_FLOAT(Source.TargetRelativeLocation.X));
+		Target.TargetRelativeLocation[1] = QuantizeLocation(UE_REAL_TO_FLOAT(Source.TargetRelativeLocation.Y));
+		Target.TargetRelativeLocation[2] = QuantizeLocation(UE_REAL_TO_FLOAT(Source.TargetRelativeLocation.Z));
+
+		Target.TargetRelativeRotation[0] = FRotator::CompressAxisToShort(Source.TargetRelativeRotation.Pitch);
+		Target.TargetRelativeRotation[1] = FRotator::CompressAxisToShort(Source.TargetRelativeRotation.Yaw);
+		Target.TargetRelativeRotation[2] = FRotator::CompressAxisToShort(Source.TargetRelativeRotation.Roll);
+
+		Target.MantlingHeight = QuantizeLocation(Source.MantlingHeight);
+
+		Target.MantlingType = static_cast<uint8>(Source.MantlingType);
+	}
+
+	void FAlsMantlingParametersNetSerializer::Dequantize(FNetSerializationContext& Context, const FNetDequantizeArgs& Args)
+	{
+		const auto& Source{*reinterpret_cast<const QuantizedType*>(Args.Source)};
+		auto& Target{*reinterpret_cast<SourceType*>(Args.Target)};
+
+		auto ObjectArgs{Args};
+		ObjectArgs.NetSerializerConfig = NetSerializerConfigParam{ObjectNetSerializerConfig};
+		ObjectArgs.Source = NetSerializerValuePointer(&Source.TargetPrimitive);
+		ObjectArgs.Target = NetSerializerValuePointer(&Target.TargetPrimitive);
+
+		ObjectNetSerializer->Dequantize(Context, ObjectArgs);
+
+		Target.TargetRelativeLocation.X = Source.TargetRelativeLocation[0] / LocationScale;
+		Target.TargetRelativeLocation.Y = Source.TargetRelativeLocation[1] / LocationScale;
+		Target.TargetRelativeLocation.Z = Source.TargetRelativeLocation[2] / LocationScale;
+
+		Target.TargetRelativeRotation.Pitch = FRotator::DecompressAxisFromShort(Source.TargetRelativeRotation[0]);
+		Target.TargetRelativeRotation.Yaw = FRotator::DecompressAxisFromShort(Source.TargetRelativeRotation[1]);
+		Target.TargetRelativeRotation.Roll = FRotator::DecompressAxisFromShort(Source.TargetRelativeRotation[2]);
+		Target.TargetRelativeRotation.Normalize();
+
+		Target.MantlingHeight = Source.MantlingHeight / LocationScale;
+
+		Target.MantlingType = static_cast<EAlsMantlingType>(Source.MantlingType);
+	}
+
+	bool FAlsMantlingParametersNetSerializer::IsEqual(FNetSerializationContext& Context, const FNetIsEqualArgs& Args)
+	{
+		if (Args.bStateIsQuantized)
+		{
+			const auto& Value0{*reinterpret_cast<const QuantizedType*>(Args.Source0)};
+			const auto& Value1{*reinterpret_cast<const QuantizedType*>(Args.Source1)};
+
+			return Value0.TargetPrimitive == Value1.TargetPrimitive &&
+			       FMemory::Memcmp(Value0.TargetRelativeLocation, Value1.TargetRelativeLocation,
+			                       sizeof(Value0.TargetRelativeLocation)) == 0 &&
+			       FMemory::Memcmp(Value0.TargetRelativeRotation, Value1.TargetRelativeRotation,
+			                       sizeof(Value0.TargetRelativeRotation)) == 0 &&
+			       Value0.MantlingHeight == Value1.MantlingHeight &&
+			       Value0.MantlingType == Value1.MantlingType;
+		}
+
+		const auto& Value0{*reinterpret_cast<const SourceType*>(Args.Source0)};
+		const auto& Value1{*reinterpret_cast<const SourceType*>(Args.Source1)};
+
+		return Value0.TargetPrimitive == Value1.TargetPrimitive &&
+		       Value0.TargetRelativeLocation == Value1.TargetRelativeLocation &&
+		       Value0.TargetRelativeRotation == Value1.TargetRelativeRotation &&
+		       Value0.MantlingHeight == Value1.MantlingHeight &&
+		       Value0.MantlingType == Value1.MantlingType;
+	}
+
+	bool FAlsMantlingParametersNetSerializer::Validate(FNetSerializationContext& Context, const FNetValidateArgs& Args)
+	{
+		const auto& Source{*reinterpret_cast<const SourceType*>(Args.Source)};
+
+		return static_cast<uint8>(Source.MantlingType) <= static_cast<uint8>(EAlsMantlingType::InAir) &&
+		       !Source.TargetRelativeLocation.ContainsNaN() && !Source.TargetRelativeRotation.ContainsNaN() &&
+		       FMath::IsFinite(Source.MantlingHeight);
+	}
+
+	void FAlsMantlingParametersNetSerializer::CollectNetReferences(FNetSerializationContext& Context, const FNetCollectReferencesArgs& Args)
+	{
+		const auto& Value{*reinterpret_cast<const QuantizedType*>(Args.Source)};
+
+		auto ObjectArgs{Args};
+		ObjectArgs.NetSerializerConfig = NetSerializerConfigParam{ObjectNetSerializerConfig};
+		ObjectArgs.Source = NetSerializerValuePointer(&Value.TargetPrimitive);
+
+		ObjectNetSerializer->CollectNetReferences(Context, ObjectArgs);
+	}
+}
+
+#endif
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Iris/Serialization/NetSerializer.h"
+#include "AlsMantlingParametersNetSerializer.generated.h"
+
+USTRUCT()
+struct FAlsMantlingParametersNetSerializerConfig : public FNetSerializerConfig
+{
+	GENERATED_BODY()
+};
+
+namespace UE::Net
+{
+	// Iris counterpart of FAlsMantlingParameters::NetSerialize(). Quantizes the target location and mantling height to 0.01 cm
+	// and the target rotation to 16 bits per axis, and only sends the members that differ from the previous state when delta
+	// serializing. The target primitive is forwarded to the weak object net serializer.
+	UE_NET_DECLARE_SERIALIZER(FAlsMantlingParametersNetSerializer, ALS_API);
+}
@@ -2,6 +2,42 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsMantlingSettings)
 
+bool FAlsMantlingParameters::NetSerialize(FArchive& Archive, UPackageMap* Map, bool& bSuccess)
+{
+	bSuccess = true;
+
+	Archive << TargetPrimitive;
+
+	bSuccess &= SerializePackedVector<100, 30>(TargetRelativeLocation, Archive);
+
+	// The target rotation is only used to rotate the character on the mantling target, so 16 bits per axis is enough.
+
+	TargetRelativeRotation.SerializeCompressedShort(Archive);
+
+	if (Archive.IsLoading())
+	{
+		TargetRelativeRotation.Normalize();
+	}
+
+	Archive << MantlingHeight;
+
+	static_assert(static_cast<uint8>(EAlsMantlingType::InAir) < 1 << 2);
+
+	auto MantlingTypeValue{static_cast<uint8>(MantlingType)};
+	Archive.SerializeBits(&MantlingTypeValue, 2);
+
+	if (Archive.IsLoading())
+	{
+		// Values outside of the enumeration can only come from a malformed or malicious packet.
+
+		bSuccess &= MantlingTypeValue <= static_cast<uint8>(EAlsMantlingType::InAir);
+
+		MantlingType = static_cast<EAlsMantlingType>(FMath::Min(MantlingTypeValue, static_cast<uint8>(EAlsMantlingType::InAir)));
+	}
+
+	return true;
+}
+
 #if WITH_EDITOR
 void FAlsGeneralMantlingSettings::PostEditChangeProperty(const FPropertyChangedEvent& ChangedEvent)
 {
@@ -0,0 +1,113 @@
+#include "Utility/AlsCorrectionRecordBuffer.h"
+
+#include "AlsCharacter.h"
+#include "AlsCharacterMovementComponent.h"
+#include "EngineUtils.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/OutputDevice.h"
+#include "Misc/Paths.h"
+
+#if !UE_BUILD_SHIPPING
+namespace AlsCorrectionRecords
+{
+	bool bEnabled{false};
+
+	FAutoConsoleVariableRef ConsoleVariableEnabled{
+		TEXT("Als.Corrections.Record"), bEnabled,
+		TEXT("If enabled, the recent network corrections of the server and autonomous proxy characters are recorded. ")
+		TEXT("Use the Als.Corrections.Dump console command to save them."), ECVF_Default
+	};
+
+	void DumpCorrectionRecords(const TArray<FString>& Arguments, UWorld* World, FOutputDevice& Output)
+	{
+		TStringBuilder<4096> CsvBuilder;
+		CsvBuilder << TEXTVIEW("World,Character,") << FAlsCorrectionRecord::GetCsvHeader() << LINE_TERMINATOR;
+
+		auto RecordsCount{0};
+
+		// Go through all worlds, so that both the server and the clients are included when playing in editor in a single process.
+
+		for (const auto& WorldContext : GEngine->GetWorldContexts())
+		{
+			const auto* ContextWorld{WorldContext.World()};
+			if (!IsValid(ContextWorld))
+			{
+				continue;
+			}
+
+			for (const auto* Character : TActorRange<AAlsCharacter>{ContextWorld})
+			{
+				const auto* CharacterMovement{Cast<UAlsCharacterMovementComponent>(Character->GetCharacterMovement())};
+				const auto* CorrectionRecords{IsValid(CharacterMovement) ? CharacterMovement->GetCorrectionRecords() : nullptr};
+
+				if (CorrectionRecords == nullptr)
+				{
+					continue;
+				}
+
+				CorrectionRecords->ForEach([&](const FAlsCorrectionRecord& Record)
+				{
+					CsvBuilder << ContextWorld->GetName() << TEXT(',') << Character->GetName() << TEXT(',')
+						<< Record.ToCsvRow() << LINE_TERMINATOR;
+
+					RecordsCount += 1;
+				});
+			}
+		}
+
+		const auto FilePath{
+			FPaths::ProfilingDir() / (Arguments.IsEmpty()
+				                          ? FString::Printf(TEXT("AlsCorrections-%s.csv"), *FDateTime::Now().ToString())
+				                          : Arguments[0])
+		};
+
+		if (!bEnabled)
+		{
+			Output.Logf(TEXT("Correction recording is disabled, set Als.Corrections.Record to 1 to enable it."));
+		}
+
+		if (FFileHelper::SaveStringToFile(CsvBuilder.ToView(), *FilePath))
+		{
+			Output.Logf(TEXT("Saved %d correction records to %s."), RecordsCount, *FilePath);
+		}
+		else
+		{
+			Output.Logf(TEXT("Failed to save the correction records to %s."), *FilePath);
+		}
+	}
+
+	FAutoConsoleCommandWithWorldArgsAndOutputDevice ConsoleCommandDump{
+		TEXT("Als.Corrections.Dump"),
+		TEXT("Saves the recent network corrections of all ALS characters of all worlds to a CSV file in the profiling directory. ")
+		TEXT("Arguments: [FileName]."),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&DumpCorrectionRecords)
+	};
+}
+#endif
+
+bool AlsCorrectionRecords::IsEnabled()
+{
+#if !UE_BUILD_SHIPPING
+	return bEnabled;
+#else
+	return false;
+#endif
+}
+
+const TCHAR* FAlsCorrectionRecord::GetCsvHeader()
+{
+	return TEXT("Time,MoveTimeStamp,Side,RotationMode,Stance,MaxAllowedGait,MovementMode,MaxForwardSpeed,MaxBackwardSpeed,")
+		TEXT("LocationDeltaX,LocationDeltaY,LocationDeltaZ,LocationDeltaSize,RootMotionActive,MantlingRootMotionActive,CombinedMove");
+}
+
+FString FAlsCorrectionRecord::ToCsvRow() const
+{
+	return FString::Printf(TEXT("%.4f,%.4f,%s,%s,%s,%s,%s,%.2f,%.2f,%.3f,%.3f,%.3f,%.3f,%d,%d,%d"),
+	                       Time, MoveTimeStamp, bServer ? TEXT("Server") : TEXT("Client"),
+	                       *RotationMode.ToString(), *Stance.ToString(), *MaxAllowedGait.ToString(),
+	                       *StaticEnum<EMovementMode>()->GetNameStringByValue(MovementMode),
+	                       MaxSpeeds.X, MaxSpeeds.Y, LocationDelta.X, LocationDelta.Y, LocationDelta.Z, LocationDelta.Size(),
+	                       bRootMotionActive ? 1 : 0, bMantlingRootMotionActive ? 1 : 0, bCombinedMove ? 1 : 0);
+}
@@ -0,0 +1,209 @@
+#include "Utility/AlsCostTracking.h"
+
+#include "AlsCharacter.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+#include "Misc/OutputDevice.h"
+
+namespace AlsCostTracking
+{
+	bool bEnabled{false};
+
+	void ResetCosts(IConsoleVariable* ConsoleVariable)
+	{
+		// Start from scratch whenever the tracking is toggled, so that the averages measured
+		// before the tracking was disabled are not reported as if they were still current.
+
+		for (auto* Character : TObjectRange<AAlsCharacter>{})
+		{
+			Character->GetCosts().Reset();
+		}
+	}
+
+	FAutoConsoleVariableRef ConsoleVariableEnabled{
+		TEXT("Als.Cost.Enabled"), bEnabled,
+		TEXT("If enabled, the time spent on each ALS character is measured per category. ")
+		TEXT("Use the Als.Cost.Top console command to list the costliest characters."),
+		FConsoleVariableDelegate::CreateStatic(&ResetCosts), ECVF_Default
+	};
+
+	thread_local FAlsCharacterCosts* ThreadCosts{nullptr};
+
+	void PrintCostliestCharacters(const TArray<FString>& Arguments, UWorld* World, FOutputDevice& Output)
+	{
+		static constexpr auto DefaultCount{10};
+
+		auto Count{DefaultCount};
+
+		if (Arguments.Num() > 0)
+		{
+			LexFromString(Count, *Arguments[0]);
+		}
+
+		if (!bEnabled)
+		{
+			Output.Logf(TEXT("Cost tracking is disabled, set Als.Cost.Enabled to 1 to enable it."));
+			return;
+		}
+
+		TArray<const AAlsCharacter*> Characters;
+		GetCostliestCharacters(World, FMath::Max(1, Count), Characters);
+
+		TStringBuilder<512> LineBuilder;
+
+		for (const auto* Character : Characters)
+		{
+			const auto& Costs{Character->GetCosts()};
+
+			LineBuilder.Reset();
+			LineBuilder.Appendf(TEXT("%s: %.3f ms"), *Character->GetName(), Costs.GetTotalAverageMilliseconds());
+
+			for (auto i{0}; i < CategoriesCount; i++)
+			{
+				const auto Category{static_cast<EAlsCostCategory>(i)};
+
+				LineBuilder.Appendf(TEXT(", %s %.3f"), GetCategoryName(Category), Costs.GetAverageMilliseconds(Category));
+			}
+
+			Output.Log(LineBuilder.ToString());
+		}
+	}
+
+	FAutoConsoleCommandWithWorldArgsAndOutputDevice ConsoleCommandTop{
+		TEXT("Als.Cost.Top"),
+		TEXT("Lists the costliest ALS characters of the world by their average time per frame. Arguments: [Count]."),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&PrintCostliestCharacters)
+	};
+
+	bool IsEnabled()
+	{
+		return bEnabled;
+	}
+
+	const TCHAR* GetCategoryName(const EAlsCostCategory Category)
+	{
+		switch (Category)
+		{
+			case EAlsCostCategory::CharacterTick:
+				return TEXT("Character Tick");
+
+			case EAlsCostCategory::View:
+				return TEXT("View");
+
+			case EAlsCostCategory::Locomotion:
+				return TEXT("Locomotion");
+
+			case EAlsCostCategory::Rotation:
+				return TEXT("Rotation");
+
+			case EAlsCostCategory::Mantling:
+				return TEXT("Mantling");
+
+			case EAlsCostCategory::Ragdolling:
+				return TEXT("Ragdolling");
+
+			case EAlsCostCategory::AnimationGameThread:
+				return TEXT("Animation Game Thread");
+
+			case EAlsCostCategory::AnimationWorkerThread:
+				return TEXT("Animation Worker Thread");
+
+			case EAlsCostCategory::SceneQueries:
+				return TEXT("Scene Queries");
+
+			default:
+				return TEXT("Unknown");
+		}
+	}
+
+	void GetCostliestCharacters(const UWorld* World, const int32 MaxCount, TArray<const AAlsCharacter*>& Characters)
+	{
+		Characters.Reset();
+
+		if (!IsValid(World))
+		{
+			return;
+		}
+
+		for (const auto* Character : TActorRange<AAlsCharacter>{World})
+		{
+			Characters.Emplace(Character);
+		}
+
+		Characters.Sort([](const AAlsCharacter& A, const AAlsCharacter& B)
+		{
+			return A.GetCosts().GetTotalAverageMilliseconds() > B.GetCosts().GetTotalAverageMilliseconds();
+		});
+
+		if (Characters.Num() > MaxCount)
+		{
+			Characters.SetNum(MaxCount, EAllowShrinking::No);
+		}
+	}
+}
+
+FAlsCharacterCosts::FAlsCharacterCosts()
+{
+	for (auto& Cycles : FrameCycles)
+	{
+		Cycles.store(0, std::memory_order_relaxed);
+	}
+}
+
+void FAlsCharacterCosts::Reset()
+{
+	check(IsInGameThread())
+
+	for (auto i{0}; i < AlsCostTracking::CategoriesCount; i++)
+	{
+		FrameCycles[i].store(0, std::memory_order_relaxed);
+		AverageMilliseconds[i] = 0.0f;
+	}
+}
+
+void FAlsCharacterCosts::Refresh()
+{
+	check(IsInGameThread())
+
+	for (auto i{0}; i < AlsCostTracking::CategoriesCount; i++)
+	{
+		const auto Cycles{FrameCycles[i].exchange(0, std::memory_order_relaxed)};
+
+		AverageMilliseconds[i] = FMath::Lerp(AverageMilliseconds[i], static_cast<float>(FPlatformTime::ToMilliseconds64(Cycles)),
+		                                     AverageSmoothingFactor);
+	}
+}
+
+FAlsCostScope::FAlsCostScope(FAlsCharacterCosts* NewCosts, const EAlsCostCategory NewCategory)
+{
+	if (NewCosts == nullptr || !AlsCostTracking::bEnabled)
+	{
+		return;
+	}
+
+	Costs = NewCosts;
+	Category = NewCategory;
+
+	PreviousThreadCosts = AlsCostTracking::ThreadCosts;
+	AlsCostTracking::ThreadCosts = Costs;
+
+	StartCycles = FPlatformTime::Cycles64();
+}
+
+FAlsCostScope::~FAlsCostScope()
+{
+	if (Costs == nullptr)
+	{
+		return;
+	}
+
+	Costs->AddCycles(Category, FPlatformTime::Cycles64() - StartCycles);
+
+	AlsCostTracking::ThreadCosts = PreviousThreadCosts;
+}
+
+FAlsCharacterCosts* FAlsCostScope::GetThreadCosts()
+{
+	return AlsCostTracking::ThreadCosts;
+}
@@ -0,0 +1,90 @@
+#include "Utility/AlsCrowdStorage.h"
+
+#include "Utility/AlsVector.h"
+
+int32 FAlsCrowdStorage::Add()
+{
+	FrameNumbers.Emplace(0);
+	Velocities.Emplace(ForceInit);
+	InputDirections.Emplace(ForceInit);
+	MovingSpeedThresholds.Emplace(0.0f);
+	RotationYawSpeeds.Emplace(0.0f);
+	RotationYawOffsets.Emplace(0.0f);
+	GaitAmounts.Emplace(0.0f);
+	RotationInterpolationSpeedCurves.Emplace(nullptr);
+	RotationInterpolationSpeeds.Emplace(0.0f);
+	Speeds.Emplace(0.0f);
+	VelocityYawAngles.Emplace(0.0f);
+	InputYawAngles.Emplace(0.0f);
+
+	return Flags.Emplace(0);
+}
+
+void FAlsCrowdStorage::RemoveAtSwap(const int32 Index)
+{
+	FrameNumbers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Velocities.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	InputDirections.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	MovingSpeedThresholds.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	RotationYawSpeeds.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	RotationYawOffsets.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	GaitAmounts.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	RotationInterpolationSpeedCurves.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	RotationInterpolationSpeeds.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Speeds.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	VelocityYawAngles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	InputYawAngles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Flags.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+void FAlsCrowdStorage::Reset()
+{
+	FrameNumbers.Reset();
+
+	Velocities.Reset();
+	InputDirections.Reset();
+	MovingSpeedThresholds.Reset();
+	RotationYawSpeeds.Reset();
+	RotationYawOffsets.Reset();
+	GaitAmounts.Reset();
+	RotationInterpolationSpeedCurves.Reset();
+	RotationInterpolationSpeeds.Reset();
+	Speeds.Reset();
+	VelocityYawAngles.Reset();
+	InputYawAngles.Reset();
+	Flags.Reset();
+}
+
+void FAlsCrowdStorage::Calculate(const int32 Index)
+{
+	// Same calculations as in AAlsCharacter::RefreshInput() and AAlsCharacter::RefreshLocomotion().
+
+	const auto& InputDirection{InputDirections[Index]};
+	const auto& Velocity{Velocities[Index]};
+
+	uint8 NewFlags{0};
+
+	if (InputDirection.SizeSquared() > UE_KINDA_SMALL_NUMBER)
+	{
+		NewFlags |= EFlags::HasInput;
+		InputYawAngles[Index] = UE_REAL_TO_FLOAT(UAlsVector::DirectionToAngleXY(InputDirection));
+	}
+
+	Speeds[Index] = UE_REAL_TO_FLOAT(Velocity.Size2D());
+
+	if (Speeds[Index] >= HasSpeedThreshold)
+	{
+		NewFlags |= EFlags::HasVelocity;
+		VelocityYawAngles[Index] = UE_REAL_TO_FLOAT(UAlsVector::DirectionToAngleXY(Velocity));
+	}
+
+	if (((NewFlags & EFlags::HasInput) != 0 && (NewFlags & EFlags::HasVelocity) != 0) ||
+	    Speeds[Index] > MovingSpeedThresholds[Index])
+	{
+		NewFlags |= EFlags::Moving;
+	}
+
+	Flags[Index] = NewFlags;
+
+	FrameNumbers[Index] = GFrameCounter;
+}
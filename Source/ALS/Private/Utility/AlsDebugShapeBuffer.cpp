@@ -0,0 +1,62 @@
+#include "Utility/AlsDebugShapeBuffer.h"
+
+#include "Engine/HitResult.h"
+#include "Misc/OutputDevice.h"
+#include "Utility/AlsDebugUtility.h"
+
+void FAlsDebugShape::Draw(const UWorld* World) const
+{
+#if ENABLE_DRAW_DEBUG
+	FHitResult Hit;
+	Hit.bBlockingHit = bHit;
+	Hit.Location = HitLocation;
+	Hit.ImpactPoint = HitImpactPoint;
+
+	switch (Type)
+	{
+		case EAlsDebugShapeType::LineTrace:
+			UAlsDebugUtility::DrawLineTraceSingle(World, Start, End, bHit, Hit, TraceColor, HitColor, Duration);
+			break;
+
+		case EAlsDebugShapeType::SweepSphere:
+			UAlsDebugUtility::DrawSweepSingleSphere(World, Start, End, Radius, bHit, Hit, TraceColor, HitColor, Duration);
+			break;
+
+		case EAlsDebugShapeType::SweepCapsule:
+			UAlsDebugUtility::DrawSweepSingleCapsule(World, Start, End, Rotation, Radius, HalfHeight,
+			                                         bHit, Hit, TraceColor, HitColor, Duration);
+			break;
+	}
+#endif
+}
+
+FString FAlsDebugShape::ToString() const
+{
+	static const TCHAR* TypeNames[]{TEXT("Line Trace"), TEXT("Sweep Sphere"), TEXT("Sweep Capsule")};
+
+	return FString::Printf(TEXT("%s: Start: %s, End: %s, Radius: %.2f, Half Height: %.2f, Hit: %s, Hit Location: %s, Duration: %.2f"),
+	                       TypeNames[static_cast<uint8>(Type)], *Start.ToString(), *End.ToString(), Radius, HalfHeight,
+	                       bHit ? TEXT("True") : TEXT("False"), *HitLocation.ToString(), Duration);
+}
+
+void FAlsDebugShapeBuffer::Drain(const UWorld* World)
+{
+	check(IsInGameThread())
+
+	ForEach(DrainedCount, [World](const FAlsDebugShape& Shape)
+	{
+		Shape.Draw(World);
+	});
+
+	DrainedCount = WriteCount.load(std::memory_order_acquire);
+}
+
+void FAlsDebugShapeBuffer::Dump(FOutputDevice& Output) const
+{
+	Output.Logf(TEXT("Debug shapes: %d (capacity %d)"), Num(), Capacity);
+
+	ForEach(0, [&Output](const FAlsDebugShape& Shape)
+	{
+		Output.Log(Shape.ToString());
+	});
+}
@@ -11,11 +11,15 @@
 
 bool UAlsDebugUtility::ShouldDisplayDebugForActor(const AActor* Actor, const FName& DisplayName)
 {
+#if ENABLE_DRAW_DEBUG
 	const auto* World{IsValid(Actor) ? Actor->GetWorld() : nullptr};
 	const auto* Player{IsValid(World) ? World->GetFirstPlayerController() : nullptr};
 	auto* Hud{IsValid(Player) ? Player->GetHUD() : nullptr};
 
 	return IsValid(Hud) && Hud->ShouldDisplayDebug(DisplayName) && Hud->GetCurrentDebugTargetActor() == Actor;
+#else
+	return false;
+#endif
 }
 
 void UAlsDebugUtility::DrawHalfCircle(const UObject* WorldContext, const FVector& Location, const FVector& XAxis,
@@ -0,0 +1,31 @@
+#include "Utility/AlsFixedTimeStep.h"
+
+#include "Math/UnrealMathUtility.h"
+
+void FAlsFixedTimeStep::Advance(const float DeltaTime, const float NewTimeStep, const int32 MaxSubstepsCount)
+{
+	if (NewTimeStep <= UE_SMALL_NUMBER)
+	{
+		TimeStep = 0.0f;
+		Remainder = 0.0f;
+		SubstepsCount = 0;
+		return;
+	}
+
+	TimeStep = NewTimeStep;
+
+	const auto ClampedDeltaTime{FMath::Max(0.0f, DeltaTime)};
+
+	SubstepsCount = FMath::FloorToInt32(ClampedDeltaTime / TimeStep);
+
+	if (SubstepsCount >= MaxSubstepsCount)
+	{
+		// Drop the excess time.
+
+		SubstepsCount = FMath::Max(1, MaxSubstepsCount);
+		Remainder = 0.0f;
+		return;
+	}
+
+	Remainder = FMath::Max(0.0f, ClampedDeltaTime - SubstepsCount * TimeStep);
+}
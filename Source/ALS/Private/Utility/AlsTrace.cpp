@@ -0,0 +1,144 @@
+﻿#include "Utility/AlsTrace.h"
+
+#if ALS_TRACE_ENABLED
+#include "GameFramework/Actor.h"
+#include "ProfilingDebugging/MiscTrace.h"
+
+UE_TRACE_CHANNEL_DEFINE(AlsChannel)
+
+UE_TRACE_EVENT_BEGIN(Als, StateChanged)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, ActorId)
+	UE_TRACE_EVENT_FIELD(uint8, Type)
+	UE_TRACE_EVENT_FIELD(uint32, ValueIndex)
+	UE_TRACE_EVENT_FIELD(uint32, ValueNumber)
+UE_TRACE_EVENT_END()
+
+// Important events are kept by the trace system and sent again to every new trace session,
+// so actors and names traced before the session was started are still resolved in it.
+
+UE_TRACE_EVENT_BEGIN(Als, ActorName, NoSync | Important)
+	UE_TRACE_EVENT_FIELD(uint32, ActorId)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Name)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Als, ValueName, NoSync | Important)
+	UE_TRACE_EVENT_FIELD(uint32, Index)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Name)
+UE_TRACE_EVENT_END()
+
+namespace AlsTrace
+{
+	const TCHAR* GetEventTypeName(const EAlsTraceEventType Type)
+	{
+		switch (Type)
+		{
+			case EAlsTraceEventType::LocomotionMode:
+				return TEXT("LocomotionMode");
+
+			case EAlsTraceEventType::RotationMode:
+				return TEXT("RotationMode");
+
+			case EAlsTraceEventType::Stance:
+				return TEXT("Stance");
+
+			case EAlsTraceEventType::Gait:
+				return TEXT("Gait");
+
+			case EAlsTraceEventType::LocomotionAction:
+				return TEXT("LocomotionAction");
+
+			case EAlsTraceEventType::TurnInPlace:
+				return TEXT("TurnInPlace");
+
+			case EAlsTraceEventType::Transition:
+				return TEXT("Transition");
+
+			case EAlsTraceEventType::FootLockEngaged:
+				return TEXT("FootLockEngaged");
+
+			case EAlsTraceEventType::FootLockReleased:
+				return TEXT("FootLockReleased");
+
+			default:
+				return TEXT("Unknown");
+		}
+	}
+
+	// Actors and names already traced by the current thread. Each thread keeps its own cache, so no locking is needed,
+	// at the cost of a name being traced once by each thread that uses it, which is harmless for important events.
+
+	thread_local TSet<uint32> TracedActorIds;
+
+	thread_local TSet<uint32> TracedNameIndices;
+
+	void TraceActorNameOnce(const AActor& Actor)
+	{
+		bool bAlreadyTraced;
+		TracedActorIds.Add(Actor.GetUniqueID(), &bAlreadyTraced);
+
+		if (bAlreadyTraced)
+		{
+			return;
+		}
+
+		TCHAR NameString[NAME_SIZE];
+		const auto NameLength{Actor.GetFName().ToString(NameString, NAME_SIZE)};
+
+		UE_TRACE_LOG(Als, ActorName, AlsChannel)
+			<< ActorName.ActorId(Actor.GetUniqueID())
+			<< ActorName.Name(NameString, NameLength);
+	}
+
+	void TraceNameOnce(const FName& Name)
+	{
+		const auto NameIndex{Name.GetComparisonIndex().ToUnstableInt()};
+
+		bool bAlreadyTraced;
+		TracedNameIndices.Add(NameIndex, &bAlreadyTraced);
+
+		if (bAlreadyTraced)
+		{
+			return;
+		}
+
+		TCHAR NameString[NAME_SIZE];
+		const auto NameLength{FName{Name, NAME_NO_NUMBER_INTERNAL}.ToString(NameString, NAME_SIZE)};
+
+		UE_TRACE_LOG(Als, ValueName, AlsChannel)
+			<< ValueName.Index(NameIndex)
+			<< ValueName.Name(NameString, NameLength);
+	}
+}
+
+void AlsTrace::TraceStateChanged(const AActor* Actor, const EAlsTraceEventType Type, const FName& Value)
+{
+	if (!UE_TRACE_CHANNELEXPR_IS_ENABLED(AlsChannel) || !IsValid(Actor))
+	{
+		return;
+	}
+
+	TraceActorNameOnce(*Actor);
+	TraceNameOnce(Value);
+
+	UE_TRACE_LOG(Als, StateChanged, AlsChannel)
+		<< StateChanged.Cycle(FPlatformTime::Cycles64())
+		<< StateChanged.ActorId(Actor->GetUniqueID())
+		<< StateChanged.Type(static_cast<uint8>(Type))
+		<< StateChanged.ValueIndex(Value.GetComparisonIndex().ToUnstableInt())
+		<< StateChanged.ValueNumber(static_cast<uint32>(Value.GetNumber()));
+
+	if (UE_TRACE_CHANNELEXPR_IS_ENABLED(BookmarkChannel))
+	{
+		// Also show the change on the timeline of Unreal Insights, which doesn't display custom events.
+
+		TCHAR ActorString[NAME_SIZE];
+		Actor->GetFName().ToString(ActorString, NAME_SIZE);
+
+		TCHAR ValueString[NAME_SIZE];
+		Value.ToString(ValueString, NAME_SIZE);
+
+		TRACE_BOOKMARK(TEXT("Als %s: %s, %s"), GetEventTypeName(Type), ActorString, ValueString);
+	}
+}
+#endif
@@ -10,6 +10,8 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsUtility)
 
+CSV_DEFINE_CATEGORY_MODULE(ALS_API, Als, true);
+
 FString UAlsUtility::NameToDisplayString(const FName& Name, const bool bNameIsBool)
 {
 	return FName::NameToDisplayString(Name.ToString(), bNameIsBool);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "AlsSceneQuerySubsystem.h"
 #include "Animation/AnimInstance.h"
 #include "Engine/World.h"
 #include "State/AlsControlRigInput.h"
@@ -21,6 +22,7 @@
 #include "State/AlsTransitionsState.h"
 #include "State/AlsTurnInPlaceState.h"
 #include "State/AlsViewAnimationState.h"
+#include "Utility/AlsDebugShapeBuffer.h"
 #include "Utility/AlsGameplayTags.h"
 #include "AlsAnimationInstance.generated.h"
 
@@ -54,7 +56,7 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
 	uint8 bDisplayDebugTraces : 1 {false};
 
-	mutable TArray<TFunction<void()>> DisplayDebugTracesQueue;
+	mutable FAlsDebugShapeBuffer DisplayDebugTracesBuffer;
 #endif
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
@@ -117,6 +119,16 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
 	FAlsInAirState InAirState;
 
+	FAlsSceneQueryHandle GroundPredictionSweepHandle;
+
+	// Result of the last completed ground prediction sweep, reused while a deferred
+	// sweep is pending or while the ground prediction scene query budget is exceeded.
+	FHitResult GroundPredictionSweepHit;
+
+	// Number of consecutive frames in which the last ground prediction sweep result was
+	// reused because the budget was exceeded. Its time was measured from an older location.
+	int32 GroundPredictionSweepHitReusesCount{0};
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
 	FAlsFeetState FeetState;
 
@@ -163,6 +175,10 @@ public:
 
 	void MarkTeleported();
 
+#if WITH_EDITORONLY_DATA
+	void DumpDisplayDebugTraces(FOutputDevice& Output) const;
+#endif
+
 private:
 	void RefreshMovementBaseOnGameThread();
 
@@ -370,6 +386,13 @@ inline void UAlsAnimationInstance::MarkTeleported()
 	TeleportedTime = GetWorld()->GetTimeSeconds();
 }
 
+#if WITH_EDITORONLY_DATA
+inline void UAlsAnimationInstance::DumpDisplayDebugTraces(FOutputDevice& Output) const
+{
+	DisplayDebugTracesBuffer.Dump(Output);
+}
+#endif
+
 inline void UAlsAnimationInstance::SetGroundedEntryMode(const FGameplayTag& NewGroundedEntryMode)
 {
 	GroundedEntryMode = NewGroundedEntryMode;
@@ -7,22 +7,38 @@
 #include "State/AlsRagdollingState.h"
 #include "State/AlsRollingState.h"
 #include "State/AlsViewState.h"
+#include "Utility/AlsCostTracking.h"
+#include "Utility/AlsFixedTimeStep.h"
 #include "Utility/AlsGameplayTags.h"
 #include "AlsCharacter.generated.h"
 
+struct FAlsCrowdStorage;
 struct FAlsMantlingParameters;
 struct FAlsMantlingTraceSettings;
 class UAlsCharacterMovementComponent;
 class UAlsCharacterSettings;
 class UAlsMovementSettings;
 class UAlsAnimationInstance;
+class UAlsCharacterTickSubsystem;
 class UAlsMantlingSettings;
 
+enum class EAlsCharacterStateChange : uint8
+{
+	InputStarted,
+	LocomotionMode,
+	RotationMode,
+	Stance
+};
+
+using FAlsCharacterStateChangedDelegate = TMulticastDelegate<void(AAlsCharacter* Character, EAlsCharacterStateChange Change)>;
+
 UCLASS(AutoExpandCategories = ("Settings|Als Character", "Settings|Als Character|Desired State"))
 class ALS_API AAlsCharacter : public ACharacter
 {
 	GENERATED_BODY()
 
+	friend UAlsCharacterTickSubsystem;
+
 protected:
 	UPROPERTY(BlueprintReadOnly, Category = "Als Character")
 	TObjectPtr<UAlsCharacterMovementComponent> AlsCharacterMovement;
@@ -110,6 +126,27 @@ protected:
 
 	FTimerHandle BrakingFrictionFactorResetTimer;
 
+	// Used to integrate the rotation and view smoothing state, see UAlsCharacterSettings::SmoothingTimeStep.
+	FAlsFixedTimeStep SmoothingTimeStep;
+
+	// Time spent on this character, see the Als.Cost.Enabled console variable.
+	FAlsCharacterCosts Costs;
+
+	// Used by the owning client to throttle the view rotation sent to the server, see FAlsViewSettings::ViewRotationRpcAngleThreshold.
+	FRotator LastSentViewRotation{ForceInit};
+
+	double LastSentViewRotationTime{0.0};
+
+	TWeakObjectPtr<UAlsCharacterTickSubsystem> TickSubsystem;
+
+	// Index of the character in the crowd storage of the tick subsystem, or INDEX_NONE if it is not registered there.
+	int32 CrowdIndex{INDEX_NONE};
+
+public:
+	// Native counterpart of the OnLocomotionModeChanged(), OnRotationModeChanged() and OnStanceChanged() events, which also
+	// fires when the character starts receiving movement input. Allows to react to state changes without polling them.
+	FAlsCharacterStateChangedDelegate OnStateChanged;
+
 public:
 	explicit AAlsCharacter(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
@@ -128,6 +165,8 @@ public:
 protected:
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void CalcCamera(float DeltaTime, FMinimalViewInfo& ViewInfo) override;
 
 public:
@@ -144,15 +183,28 @@ public:
 public:
 	const UAlsCharacterSettings* GetSettings() const;
 
+	const FAlsCharacterCosts& GetCosts() const;
+
+	FAlsCharacterCosts& GetCosts();
+
 protected:
 	UFUNCTION(BlueprintNativeEvent, Category = "Als Character", Meta = (ReturnDisplayName = "Handled"))
 	bool OnCalculateCamera(float DeltaTime, FMinimalViewInfo& ViewInfo);
 
 private:
+	// Returns the crowd storage if the values of the character in it were prepared in the current frame.
+	const FAlsCrowdStorage* GetPreparedCrowdStorage() const;
+
 	void RefreshMeshProperties() const;
 
 	void RefreshMovementBase();
 
+	void RefreshNetUpdateFrequency();
+
+	// Returns false if the character is owned by the server and there
+	// is no remote client to which the desired state changes should be sent.
+	bool IsDesiredStateRpcRequired() const;
+
 	// View Mode
 
 public:
@@ -372,9 +424,15 @@ public:
 private:
 	void SetReplicatedViewRotation(const FRotator& NewViewRotation, bool bSendRpc);
 
+	void SendReplicatedViewRotation();
+
 	UFUNCTION(Server, Unreliable)
 	void ServerSetReplicatedViewRotation(const FRotator& NewViewRotation);
 
+	// Pitch and yaw of the view rotation compressed to 16 bits each, see FRotator::CompressAxisToShort().
+	UFUNCTION(Server, Unreliable)
+	void ServerSetReplicatedViewRotationCompressed(uint32 CompressedViewRotation);
+
 	UFUNCTION()
 	void OnReplicated_ReplicatedViewRotation();
 
@@ -615,6 +673,16 @@ inline const UAlsCharacterSettings* AAlsCharacter::GetSettings() const
 	return Settings;
 }
 
+inline const FAlsCharacterCosts& AAlsCharacter::GetCosts() const
+{
+	return Costs;
+}
+
+inline FAlsCharacterCosts& AAlsCharacter::GetCosts()
+{
+	return Costs;
+}
+
 inline const FGameplayTag& AAlsCharacter::GetViewMode() const
 {
 	return ViewMode;
@@ -2,6 +2,7 @@
 
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Settings/AlsMovementSettings.h"
+#include "Utility/AlsCorrectionRecordBuffer.h"
 #include "AlsCharacterMovementComponent.generated.h"
 
 using FAlsPhysicsRotationDelegate = TMulticastDelegate<void(float DeltaTime)>;
@@ -45,6 +46,9 @@ public:
 
 	FGameplayTag MaxAllowedGait{AlsGaitTags::Running};
 
+	// Used only for correction diagnostics.
+	uint8 bCombined : 1 {false};
+
 public:
 	virtual void Clear() override;
 
@@ -59,17 +63,58 @@ public:
 	virtual void PrepMoveFor(ACharacter* Character) override;
 };
 
+// All saved moves are allocated up front and put into the free list, which is large enough to never release them, so
+// no allocations happen while replicating moves. The capacity covers the max number of saved moves plus the pending
+// and the last acknowledged moves, since the engine doesn't create new moves once the saved moves buffer is full.
 class ALS_API FAlsNetworkPredictionData : public FNetworkPredictionData_Client_Character
 {
 private:
 	using Super = FNetworkPredictionData_Client_Character;
 
+	int32 PoolCapacity{0};
+
+	// Max number of saved moves awaiting acknowledgment at the same time on this connection,
+	// used to check whether the pool capacity can be reduced.
+	int32 PeakSavedMovesCount{0};
+
 public:
 	explicit FAlsNetworkPredictionData(const UCharacterMovementComponent& Movement);
 
+	virtual ~FAlsNetworkPredictionData() override;
+
 	virtual FSavedMovePtr AllocateNewMove() override;
+
+	virtual FSavedMovePtr CreateSavedMove(ACharacter* Character, float DeltaTime, const FVector& NewAcceleration) override;
 };
 
+// Network corrections of one character. Corrections sent to the client are counted on the
+// server, corrections received from the server are counted on the autonomous proxy.
+struct ALS_API FAlsNetworkCorrectionStatistics
+{
+	int32 CorrectionsCount{0};
+
+	float TotalCorrectionDistance{0.0f};
+
+	float MaxCorrectionDistance{0.0f};
+
+public:
+	void AddCorrection(float CorrectionDistance);
+
+	float GetAverageCorrectionDistance() const;
+};
+
+inline void FAlsNetworkCorrectionStatistics::AddCorrection(const float CorrectionDistance)
+{
+	CorrectionsCount += 1;
+	TotalCorrectionDistance += CorrectionDistance;
+	MaxCorrectionDistance = FMath::Max(MaxCorrectionDistance, CorrectionDistance);
+}
+
+inline float FAlsNetworkCorrectionStatistics::GetAverageCorrectionDistance() const
+{
+	return CorrectionsCount > 0 ? TotalCorrectionDistance / CorrectionsCount : 0.0f;
+}
+
 UCLASS(ClassGroup = "ALS")
 class ALS_API UAlsCharacterMovementComponent : public UCharacterMovementComponent
 {
@@ -124,6 +169,14 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
 	uint8 bPrePenetrationAdjustmentVelocityValid : 1 {false};
 
+	FAlsNetworkCorrectionStatistics CorrectionStatistics;
+
+#if !UE_BUILD_SHIPPING
+	// Allocated on the first recorded correction, so only on the server or the autonomous proxy
+	// and only while the Als.Corrections.Record console variable is enabled.
+	TUniquePtr<FAlsCorrectionRecordBuffer> CorrectionRecords;
+#endif
+
 public:
 	FAlsPhysicsRotationDelegate OnPhysicsRotation;
 
@@ -184,12 +237,30 @@ protected:
 
 	virtual void MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAcceleration) override;
 
+public:
+	virtual void ServerMoveHandleClientError(float ClientTimeStamp, float DeltaTime, const FVector& Accel,
+	                                         const FVector& RelativeClientLocation, UPrimitiveComponent* ClientMovementBase,
+	                                         FName ClientBaseBoneName, uint8 ClientMovementMode) override;
+
+protected:
+	virtual void OnClientCorrectionReceived(FNetworkPredictionData_Client_Character& ClientData, float TimeStamp, FVector NewLocation,
+	                                        FVector NewVelocity, UPrimitiveComponent* NewBase, FName NewBaseBoneName, bool bHasBase,
+	                                        bool bBaseRelativePosition, uint8 ServerMovementMode, FVector ServerGravityDirection) override;
+
+#if !UE_BUILD_SHIPPING
+private:
+	void RecordCorrection(const FAlsCorrectionRecord& Record);
+#endif
+
 public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Character Movement")
 	void SetMovementSettings(UAlsMovementSettings* NewMovementSettings);
 
 	const FAlsMovementGaitSettings& GetGaitSettings() const;
 
+	// Returns the gait settings for the rotation mode and stance from the movement settings, or nullptr if there are none.
+	const FAlsMovementGaitSettings* FindGaitSettings(const FGameplayTag& RotationModeTag, const FGameplayTag& StanceTag) const;
+
 private:
 	void RefreshGaitSettings();
 
@@ -219,6 +290,16 @@ public:
 	void SetInputBlocked(bool bNewInputBlocked);
 
 	bool TryConsumePrePenetrationAdjustmentVelocity(FVector& OutVelocity);
+
+	const FAlsNetworkCorrectionStatistics& GetCorrectionStatistics() const;
+
+#if !UE_BUILD_SHIPPING
+	// Recent network corrections, see the Als.Corrections.Dump console command. Returns nullptr if no corrections have been recorded.
+	const FAlsCorrectionRecordBuffer* GetCorrectionRecords() const;
+#endif
+
+	// Resets both the correction statistics and the correction records.
+	void ResetCorrectionStatistics();
 };
 
 inline const FAlsMovementGaitSettings& UAlsCharacterMovementComponent::GetGaitSettings() const
@@ -250,3 +331,24 @@ inline float UAlsCharacterMovementComponent::GetGaitAmount() const
 {
 	return GaitAmount;
 }
+
+inline const FAlsNetworkCorrectionStatistics& UAlsCharacterMovementComponent::GetCorrectionStatistics() const
+{
+	return CorrectionStatistics;
+}
+
+#if !UE_BUILD_SHIPPING
+inline const FAlsCorrectionRecordBuffer* UAlsCharacterMovementComponent::GetCorrectionRecords() const
+{
+	return CorrectionRecords.Get();
+}
+#endif
+
+inline void UAlsCharacterMovementComponent::ResetCorrectionStatistics()
+{
+	CorrectionStatistics = {};
+
+#if !UE_BUILD_SHIPPING
+	CorrectionRecords.Reset();
+#endif
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Utility/AlsCrowdStorage.h"
+#include "AlsCharacterTickSubsystem.generated.h"
+
+class AAlsCharacter;
+class UAlsCharacterTickSubsystem;
+
+USTRUCT()
+struct ALS_API FAlsCharacterTickSubsystemTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UAlsCharacterTickSubsystem* Subsystem{nullptr};
+
+public:
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+	                         const FGraphEventRef& CompletionGraphEvent) override;
+
+	virtual FString DiagnosticMessage() override;
+
+	virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+template <>
+struct TStructOpsTypeTraits<FAlsCharacterTickSubsystemTickFunction> : public TStructOpsTypeTraitsBase2<FAlsCharacterTickSubsystemTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+// Gathers all ALS characters of the world and, at the beginning of the pre physics tick group, runs the side effect free
+// part of their refresh in parallel over the crowd storage, in which the hot state of all characters is laid out as
+// a structure of arrays. The characters then consume the prepared results in their own ticks, where everything
+// that has side effects (actor rotation changes, replicated property writes, RPCs and blueprint events) is still done
+// serially. The tick functions of the character movement components of the registered characters are prerequisites of the
+// tick function of the subsystem, which in turn is a prerequisite of the tick functions of the characters, so the
+// prepared results always match the state after the movement of the current frame.
+UCLASS()
+class ALS_API UAlsCharacterTickSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Minimum number of characters processed by a single worker thread task.
+	static constexpr auto MinBatchSize{16};
+
+private:
+	// Matches the crowd storage element by element.
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AAlsCharacter>> Characters;
+
+	FAlsCrowdStorage CrowdStorage;
+
+	FAlsCharacterTickSubsystemTickFunction TickFunction;
+
+public:
+	static UAlsCharacterTickSubsystem* Get(const UWorld* World);
+
+	// Returns true if characters should register themselves in the subsystem, see the Als.Character.ParallelTick console variable.
+	static bool IsEnabled();
+
+	virtual void Deinitialize() override;
+
+protected:
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+public:
+	void RegisterCharacter(AAlsCharacter* Character);
+
+	void UnregisterCharacter(AAlsCharacter* Character);
+
+	const FAlsCrowdStorage& GetCrowdStorage() const;
+
+	void Tick(float DeltaTime);
+};
+
+inline const FAlsCrowdStorage& UAlsCharacterTickSubsystem::GetCrowdStorage() const
+{
+	return CrowdStorage;
+}
@@ -0,0 +1,167 @@
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "Components/ActorComponent.h"
+#include "AlsLocomotionReplayComponent.generated.h"
+
+class AAlsCharacter;
+
+UENUM(BlueprintType)
+enum class EAlsLocomotionReplayMode : uint8
+{
+	None,
+	Recording,
+	Playing
+};
+
+// State of the character at the start of the recording, applied before the first frame of the playback.
+struct ALS_API FAlsLocomotionReplayStartState
+{
+	FVector Location{ForceInit};
+
+	FRotator Rotation{ForceInit};
+
+	FVector Velocity{ForceInit};
+
+	FRotator ViewRotation{ForceInit};
+
+	// The locomotion mode is derived from the movement mode, so it is restored by restoring the movement mode.
+
+	uint8 MovementMode{0};
+
+	uint8 CustomMovementMode{0};
+
+	// Indices into the replay tag table.
+
+	uint8 LocomotionMode{0};
+
+	uint8 DesiredRotationMode{0};
+
+	uint8 DesiredStance{0};
+
+	uint8 DesiredGait{0};
+
+	uint8 ViewMode{0};
+
+	uint8 OverlayMode{0};
+
+	bool bDesiredAiming{false};
+
+public:
+	friend FArchive& operator<<(FArchive& Archive, FAlsLocomotionReplayStartState& StartState);
+};
+
+struct ALS_API FAlsLocomotionReplayFrame
+{
+	float DeltaTime{0.0f};
+
+	FVector3f MovementInput{ForceInit};
+
+	FRotator3f ControlRotation{ForceInit};
+
+	// Indices into the replay tag table.
+
+	uint8 DesiredRotationMode{0};
+
+	uint8 DesiredStance{0};
+
+	uint8 DesiredGait{0};
+
+	uint8 ViewMode{0};
+
+	bool bDesiredAiming{false};
+
+	// Checksum of the character state after this frame.
+	uint32 Checksum{0};
+
+public:
+	friend FArchive& operator<<(FArchive& Archive, FAlsLocomotionReplayFrame& Frame);
+};
+
+// Records the initial state of the owning character, and then its movement input, view rotation and desired state for each
+// frame, into a compact binary file and plays it back, comparing the resulting character state checksum of each frame
+// with the recorded one. For the playback
+// to be deterministic, run with a fixed time step (for example, -UseFixedTimeStep -FPS=60 -NullRHI) and possess the
+// character with a controller that doesn't apply its own input.
+UCLASS(ClassGroup = "ALS", Meta = (BlueprintSpawnableComponent))
+class ALS_API UAlsLocomotionReplayComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	static constexpr uint32 FileMagic{0x52534C41}; // "ALSR".
+	static constexpr uint32 FileVersion{2};
+
+protected:
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
+	TObjectPtr<AAlsCharacter> Character;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
+	EAlsLocomotionReplayMode Mode{EAlsLocomotionReplayMode::None};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient, Meta = (ClampMin = 0))
+	int32 FrameIndex{0};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient, Meta = (ClampMin = -1))
+	int32 FirstDivergedFrameIndex{INDEX_NONE};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient, Meta = (ClampMin = 0))
+	int32 DivergedFramesCount{0};
+
+	FAlsLocomotionReplayStartState StartState;
+
+	TArray<FName> TagNames;
+
+	TArray<FAlsLocomotionReplayFrame> Frames;
+
+public:
+	UAlsLocomotionReplayComponent();
+
+	virtual void OnRegister() override;
+
+	virtual void RegisterComponentTickFunctions(bool bRegister) override;
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	EAlsLocomotionReplayMode GetMode() const;
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Locomotion Replay")
+	void StartRecording();
+
+	// Stops the recording and saves it to the file. Relative paths are resolved against the project saved directory.
+	UFUNCTION(BlueprintCallable, Category = "ALS|Locomotion Replay", Meta = (ReturnDisplayName = "Success"))
+	bool StopRecording(const FString& FilePath);
+
+	// Loads the recording from the file and starts playing it back starting from the next frame.
+	UFUNCTION(BlueprintCallable, Category = "ALS|Locomotion Replay", Meta = (ReturnDisplayName = "Success"))
+	bool StartPlayback(const FString& FilePath);
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Locomotion Replay")
+	void StopPlayback();
+
+	uint32 CalculateStateChecksum() const;
+
+private:
+	static FString ResolveFilePath(const FString& FilePath);
+
+	void SerializeReplay(FArchive& Archive);
+
+	uint8 FindOrAddTagIndex(const FGameplayTag& Tag);
+
+	FGameplayTag GetTag(uint8 Index) const;
+
+	void RecordStartState();
+
+	void ApplyStartState() const;
+
+	void RecordFrame(float DeltaTime);
+
+	void ApplyFrame(const FAlsLocomotionReplayFrame& Frame) const;
+
+	void VerifyFrame(float DeltaTime);
+};
+
+inline EAlsLocomotionReplayMode UAlsLocomotionReplayComponent::GetMode() const
+{
+	return Mode;
+}
@@ -0,0 +1,223 @@
+#pragma once
+
+#include "CollisionQueryParams.h"
+#include "CollisionShape.h"
+#include "Containers/StaticArray.h"
+#include "Engine/HitResult.h"
+#include "Engine/World.h"
+#include "Subsystems/WorldSubsystem.h"
+#include <atomic>
+#include "AlsSceneQuerySubsystem.generated.h"
+
+struct FOverlapResult;
+
+enum class EAlsSceneQuerySource : uint8
+{
+	GroundPrediction,
+	Mantling,
+	Ragdoll,
+	Camera,
+	FootIk,
+	Footsteps
+};
+
+enum class EAlsSceneQueryStatus : uint8
+{
+	// The handle is invalid, was canceled or its result was discarded because it wasn't retrieved in time.
+	Invalid,
+	Pending,
+	Completed
+};
+
+struct ALS_API FAlsSceneQueryHandle
+{
+	uint32 Id{0};
+
+public:
+	bool IsValid() const;
+
+	void Invalidate();
+};
+
+inline bool FAlsSceneQueryHandle::IsValid() const
+{
+	return Id != 0;
+}
+
+inline void FAlsSceneQueryHandle::Invalidate()
+{
+	Id = 0;
+}
+
+// Per-world service through which ALS issues its scene queries. Deferred queries are collected from any thread during
+// the frame and dispatched together at the end of it as one batch of asynchronous traces, which the engine runs in
+// parallel on worker threads. Their results are available by handle in one of the next frames. Immediate queries run
+// on the calling thread, but are still accounted against the budgets, so the total cost of ALS scene queries in a
+// frame can be capped in one place. Deferred queries of higher priority sources are dispatched first, queries that
+// exceed the budget are kept in the queue until the next frame. Callers of immediate queries are expected to check
+// IsBudgetExceeded() beforehand and fall back to a cheaper behavior. The budgets are configured with the
+// Als.SceneQueries.Budget console variables.
+UCLASS()
+class ALS_API UAlsSceneQuerySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static constexpr auto SourcesCount{static_cast<int32>(EAlsSceneQuerySource::Footsteps) + 1};
+
+	// Unretrieved results older than this number of frames are discarded.
+	static constexpr auto MaxResultAgeFrames{30};
+
+private:
+	struct FRequest
+	{
+		FAlsSceneQueryHandle Handle;
+
+		EAlsSceneQuerySource Source{EAlsSceneQuerySource::GroundPrediction};
+
+		uint64 RequestFrame{0};
+
+		FVector Start{ForceInit};
+
+		FVector End{ForceInit};
+
+		FQuat Rotation{ForceInit};
+
+		FCollisionShape Shape;
+
+		ECollisionChannel Channel{ECC_Visibility};
+
+		FCollisionQueryParams QueryParams;
+
+		FCollisionResponseParams ResponseParams;
+	};
+
+	struct FResult
+	{
+		FHitResult Hit;
+
+		uint64 CompleteFrame{0};
+	};
+
+	TStaticArray<int32, SourcesCount> SourcePriorities{InPlace, 0};
+
+	TStaticArray<std::atomic<int32>, SourcesCount> SourceQueriesCounts;
+
+	// Deferred queries dispatched at the end of the current frame. Their asynchronous traces run during the next
+	// frame, so they are charged to it when it starts. Only accessed on the game thread.
+	TStaticArray<int32, SourcesCount> DispatchedQueriesCounts{InPlace, 0};
+
+	FDelegateHandle WorldTickStartHandle;
+
+	FCriticalSection CriticalSection;
+
+	uint32 LastHandleId{0};
+
+	TArray<FRequest> PendingRequests;
+
+	TSet<uint32> DispatchedHandleIds;
+
+	TMap<uint32, FResult> Results;
+
+	FTraceDelegate TraceDelegate;
+
+public:
+	static UAlsSceneQuerySubsystem* Get(const UWorld* World);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+public:
+	int32 GetSourcePriority(EAlsSceneQuerySource Source) const;
+
+	void SetSourcePriority(EAlsSceneQuerySource Source, int32 Priority);
+
+	// Maximum number of queries per frame for all sources combined, 0 means unlimited.
+	static int32 GetTotalBudget();
+
+	// Maximum number of queries per frame for the source, 0 means unlimited.
+	static int32 GetSourceBudget(EAlsSceneQuerySource Source);
+
+	// Number of queries of the source charged to the current frame, both immediate
+	// ones and deferred ones dispatched at the end of the previous frame.
+	int32 GetSourceQueriesCount(EAlsSceneQuerySource Source) const;
+
+	int32 GetTotalQueriesCount() const;
+
+	// Returns true if either the budget of the source or the total budget is exhausted in the current frame.
+	bool IsBudgetExceeded(EAlsSceneQuerySource Source) const;
+
+	static bool IsBudgetExceeded(const UWorld* World, EAlsSceneQuerySource Source);
+
+	// Deferred queries. Can be called from any thread.
+
+	FAlsSceneQueryHandle RequestLineTrace(EAlsSceneQuerySource Source, const FVector& Start, const FVector& End,
+	                                      ECollisionChannel Channel, const FCollisionQueryParams& QueryParams,
+	                                      const FCollisionResponseParams& ResponseParams);
+
+	FAlsSceneQueryHandle RequestSweep(EAlsSceneQuerySource Source, const FVector& Start, const FVector& End, const FQuat& Rotation,
+	                                  ECollisionChannel Channel, const FCollisionShape& Shape, const FCollisionQueryParams& QueryParams,
+	                                  const FCollisionResponseParams& ResponseParams);
+
+	// Returns the status of the query and, if it is completed, its result. A completed result can only be retrieved once.
+	EAlsSceneQueryStatus RetrieveResult(const FAlsSceneQueryHandle& Handle, FHitResult& Hit);
+
+	void Cancel(const FAlsSceneQueryHandle& Handle);
+
+	// Immediate queries. Can be called from any thread, the world is used
+	// directly if it doesn't have the subsystem, for example, in editor previews.
+
+	static bool LineTraceSingleByChannel(const UWorld* World, EAlsSceneQuerySource Source, FHitResult& Hit,
+	                                     const FVector& Start, const FVector& End, ECollisionChannel Channel,
+	                                     const FCollisionQueryParams& QueryParams,
+	                                     const FCollisionResponseParams& ResponseParams = FCollisionResponseParams::DefaultResponseParam);
+
+	static bool SweepSingleByChannel(const UWorld* World, EAlsSceneQuerySource Source, FHitResult& Hit,
+	                                 const FVector& Start, const FVector& End, const FQuat& Rotation, ECollisionChannel Channel,
+	                                 const FCollisionShape& Shape, const FCollisionQueryParams& QueryParams,
+	                                 const FCollisionResponseParams& ResponseParams = FCollisionResponseParams::DefaultResponseParam);
+
+	static bool OverlapBlockingTestByChannel(const UWorld* World, EAlsSceneQuerySource Source, const FVector& Location,
+	                                         const FQuat& Rotation, ECollisionChannel Channel, const FCollisionShape& Shape,
+	                                         const FCollisionQueryParams& QueryParams,
+	                                         const FCollisionResponseParams& ResponseParams = FCollisionResponseParams::DefaultResponseParam);
+
+	static bool OverlapMultiByChannel(const UWorld* World, EAlsSceneQuerySource Source, TArray<FOverlapResult>& Overlaps,
+	                                  const FVector& Location, const FQuat& Rotation, ECollisionChannel Channel,
+	                                  const FCollisionShape& Shape, const FCollisionQueryParams& QueryParams,
+	                                  const FCollisionResponseParams& ResponseParams = FCollisionResponseParams::DefaultResponseParam);
+
+private:
+	void OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaTime);
+
+	void AddQueries(EAlsSceneQuerySource Source, int32 Count = 1);
+
+	FAlsSceneQueryHandle AddRequest(FRequest&& Request);
+
+	void DispatchRequests();
+
+	void OnTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+};
+
+inline int32 UAlsSceneQuerySubsystem::GetSourcePriority(const EAlsSceneQuerySource Source) const
+{
+	return SourcePriorities[static_cast<int32>(Source)];
+}
+
+inline int32 UAlsSceneQuerySubsystem::GetSourceQueriesCount(const EAlsSceneQuerySource Source) const
+{
+	return SourceQueriesCounts[static_cast<int32>(Source)].load(std::memory_order_relaxed);
+}
+
+inline void UAlsSceneQuerySubsystem::AddQueries(const EAlsSceneQuerySource Source, const int32 Count)
+{
+	SourceQueriesCounts[static_cast<int32>(Source)].fetch_add(Count, std::memory_order_relaxed);
+}
@@ -1,9 +1,13 @@
 #pragma once
 
 #include "Animation/AnimNotifies/AnimNotifyState.h"
+#include "UObject/ObjectKey.h"
 #include "Utility/AlsGameplayTags.h"
 #include "AlsAnimNotifyState_EarlyBlendOut.generated.h"
 
+class AAlsCharacter;
+enum class EAlsCharacterStateChange : uint8;
+
 UCLASS(DisplayName = "Als Early Blend Out Animation Notify State")
 class ALS_API UAlsAnimNotifyState_EarlyBlendOut : public UAnimNotifyState
 {
@@ -34,6 +38,24 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", Meta = (EditCondition = "bCheckStance"))
 	FGameplayTag StanceEquals{AlsStanceTags::Crouching};
 
+private:
+	// Montage instance IDs are only meaningful within their animation instance, so pair them with it.
+	using FInstanceKey = TTuple<TObjectKey<UAnimInstance>, int32>;
+
+	struct FInstance
+	{
+		TWeakObjectPtr<AAlsCharacter> Character;
+
+		TWeakObjectPtr<UAnimInstance> AnimationInstance;
+
+		FDelegateHandle StateChangedHandle;
+	};
+
+	// Active montage instances. The notify state object is a subobject of the montage asset, so it is shared between
+	// all montage instances of all characters in all worlds, including PIE worlds, and can't store them in its own
+	// members. Entries of destroyed characters are pruned on the next begin or end. Only accessed on the game thread.
+	TMap<FInstanceKey, FInstance> Instances;
+
 public:
 	UAlsAnimNotifyState_EarlyBlendOut();
 
@@ -43,5 +65,16 @@ public:
 	virtual bool CanBePlaced(UAnimSequenceBase* Sequence) const override;
 #endif
 
-	virtual void BranchingPointNotifyTick(FBranchingPointNotifyPayload& NotifyPayload, float DeltaTime) override;
+	virtual void BranchingPointNotifyBegin(FBranchingPointNotifyPayload& NotifyPayload) override;
+
+	virtual void BranchingPointNotifyEnd(FBranchingPointNotifyPayload& NotifyPayload) override;
+
+private:
+	void RemoveInvalidInstances();
+
+	bool IsBlendOutRequired(const AAlsCharacter& Character) const;
+
+	void StopMontage(const FInstanceKey& InstanceKey);
+
+	void Character_OnStateChanged(AAlsCharacter* Character, EAlsCharacterStateChange Change, FInstanceKey InstanceKey);
 };
@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "AlsCrouchingSettings.h"
+#include "AlsDynamicMontageCache.h"
 #include "AlsDynamicTransitionsSettings.h"
 #include "AlsFeetSettings.h"
 #include "AlsGeneralAnimationSettings.h"
@@ -53,10 +54,23 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
 	FAlsGeneralTurnInPlaceSettings TurnInPlace;
 
+	// Shared between all animation instances that use these settings.
+	UPROPERTY(Transient)
+	FAlsDynamicMontageCache DynamicMontages;
+
 public:
 	UAlsAnimationInstanceSettings();
 
+	virtual void PostLoad() override;
+
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& ChangedEvent) override;
 #endif
+
+	// Builds the dynamic montages for all transition and turn in place sequences
+	// ahead of time, so that they don't need to be created during gameplay.
+	void PrebuildDynamicMontages();
+
+private:
+	void PreloadSequences() const;
 };
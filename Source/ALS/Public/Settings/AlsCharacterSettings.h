@@ -1,7 +1,9 @@
 ﻿#pragma once
 
+#include "AlsFixedTimeStepSettings.h"
 #include "AlsInAirRotationMode.h"
 #include "AlsMantlingSettings.h"
+#include "AlsNetUpdateSettings.h"
 #include "AlsRagdollingSettings.h"
 #include "AlsRollingSettings.h"
 #include "AlsViewSettings.h"
@@ -49,6 +51,9 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
 	FAlsViewSettings View;
 
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
+	FAlsFixedTimeStepSettings SmoothingTimeStep;
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
 	FAlsGeneralMantlingSettings Mantling;
 
@@ -58,6 +63,9 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
 	FAlsRollingSettings Rolling;
 
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
+	FAlsNetUpdateSettings NetUpdate;
+
 public:
 	UAlsCharacterSettings();
 
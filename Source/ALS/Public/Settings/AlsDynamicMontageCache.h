@@ -0,0 +1,58 @@
+﻿#pragma once
+
+#include "AlsDynamicMontageCache.generated.h"
+
+class UAnimMontage;
+class UAnimSequenceBase;
+
+USTRUCT()
+struct ALS_API FAlsDynamicMontageKey
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<UAnimSequenceBase> Sequence;
+
+	UPROPERTY()
+	FName SlotName;
+
+	UPROPERTY(Meta = (ForceUnits = "s"))
+	float BlendInDuration{0.0f};
+
+	UPROPERTY(Meta = (ForceUnits = "s"))
+	float BlendOutDuration{0.0f};
+
+public:
+	friend bool operator==(const FAlsDynamicMontageKey& A, const FAlsDynamicMontageKey& B)
+	{
+		return A.Sequence == B.Sequence && A.SlotName == B.SlotName &&
+		       A.BlendInDuration == B.BlendInDuration && A.BlendOutDuration == B.BlendOutDuration;
+	}
+
+	friend uint32 GetTypeHash(const FAlsDynamicMontageKey& Key)
+	{
+		auto Hash{GetTypeHash(Key.Sequence)};
+		Hash = HashCombineFast(Hash, GetTypeHash(Key.SlotName));
+		Hash = HashCombineFast(Hash, GetTypeHash(Key.BlendInDuration));
+		return HashCombineFast(Hash, GetTypeHash(Key.BlendOutDuration));
+	}
+};
+
+// Dynamic animation montages built once per unique sequence, slot and blend durations combination and then
+// reused, so that playing transitions and turn in place animations doesn't create a new montage object every time.
+// Holds at most MaxMontagesCount montages, montages for combinations beyond that are created but not cached.
+USTRUCT()
+struct ALS_API FAlsDynamicMontageCache
+{
+	GENERATED_BODY()
+
+	static constexpr auto MaxMontagesCount{64};
+
+	UPROPERTY(Transient)
+	TMap<FAlsDynamicMontageKey, TObjectPtr<UAnimMontage>> Montages;
+
+public:
+	UAnimMontage* FindOrCreate(UAnimSequenceBase* Sequence, const FName& SlotName, float BlendInDuration, float BlendOutDuration);
+
+	void Reset();
+};
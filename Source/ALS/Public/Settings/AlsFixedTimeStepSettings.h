@@ -0,0 +1,22 @@
+﻿#pragma once
+
+#include "AlsFixedTimeStepSettings.generated.h"
+
+USTRUCT(BlueprintType)
+struct ALS_API FAlsFixedTimeStepSettings
+{
+	GENERATED_BODY()
+
+	// If checked, the smoothing state (actor rotation, target yaw angle and view network smoothing) is integrated in steps
+	// no longer than the fixed time step instead of one frame delta time step, so the result doesn't depend on the frame rate.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS")
+	uint8 bEnabled : 1 {false};
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS",
+		Meta = (ClampMin = 0.001, ClampMax = 0.1, EditCondition = "bEnabled", ForceUnits = "s"))
+	float TimeStep{1.0f / 60.0f};
+
+	// Time exceeding this number of steps in one frame is dropped, so long hitches don't cause large corrections.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS", Meta = (ClampMin = 1, ClampMax = 32, EditCondition = "bEnabled"))
+	int32 MaxSubstepsCount{8};
+};
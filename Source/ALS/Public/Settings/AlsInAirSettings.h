@@ -28,6 +28,11 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "ALS", AdvancedDisplay)
 	FCollisionResponseContainer GroundPredictionSweepResponses{ECR_Ignore};
 
+	// If checked, the ground prediction sweep is deferred and batched with the sweeps of other characters by the scene query
+	// subsystem. Its result lags behind by a frame or two, which is usually not noticeable in the ground prediction blend.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
+	uint8 bDeferGroundPredictionSweep : 1 {false};
+
 public:
 #if WITH_EDITOR
 	void PostEditChangeProperty(const FPropertyChangedEvent& ChangedEvent);
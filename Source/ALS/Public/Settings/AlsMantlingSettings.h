@@ -35,6 +35,19 @@ struct ALS_API FAlsMantlingParameters
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
 	EAlsMantlingType MantlingType{EAlsMantlingType::High};
+
+public:
+	// Used by the generic replication system. Iris uses the native FAlsMantlingParametersNetSerializer instead.
+	bool NetSerialize(FArchive& Archive, UPackageMap* Map, bool& bSuccess);
+};
+
+template <>
+struct TStructOpsTypeTraits<FAlsMantlingParameters> : public TStructOpsTypeTraitsBase2<FAlsMantlingParameters>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
 };
 
 UCLASS(Blueprintable, BlueprintType)
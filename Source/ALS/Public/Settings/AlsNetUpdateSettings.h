@@ -0,0 +1,41 @@
+﻿#pragma once
+
+#include "AlsNetUpdateSettings.generated.h"
+
+USTRUCT(BlueprintType)
+struct ALS_API FAlsNetUpdateSettings
+{
+	GENERATED_BODY()
+
+	// If checked, the server drives the net update frequency and net priority of the character from its locomotion state:
+	// idle characters are replicated less often, while characters performing a locomotion action are replicated more often.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS")
+	uint8 bEnableAdaptiveNetUpdateFrequency : 1 {false};
+
+	// Used when the character is neither moving nor has any movement input.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS",
+		Meta = (ClampMin = 1, EditCondition = "bEnableAdaptiveNetUpdateFrequency", ForceUnits = "Hz"))
+	float IdleNetUpdateFrequency{10.0f};
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS",
+		Meta = (ClampMin = 0, EditCondition = "bEnableAdaptiveNetUpdateFrequency"))
+	float IdleNetPriority{1.5f};
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS",
+		Meta = (ClampMin = 1, EditCondition = "bEnableAdaptiveNetUpdateFrequency", ForceUnits = "Hz"))
+	float MovingNetUpdateFrequency{60.0f};
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS",
+		Meta = (ClampMin = 0, EditCondition = "bEnableAdaptiveNetUpdateFrequency"))
+	float MovingNetPriority{3.0f};
+
+	// Used when the character is mantling, rolling or performing any other locomotion action. Ragdolling
+	// characters use it only while the ragdoll is moving, and the idle frequency once it has settled down.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS",
+		Meta = (ClampMin = 1, EditCondition = "bEnableAdaptiveNetUpdateFrequency", ForceUnits = "Hz"))
+	float ActionNetUpdateFrequency{100.0f};
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS",
+		Meta = (ClampMin = 0, EditCondition = "bEnableAdaptiveNetUpdateFrequency"))
+	float ActionNetPriority{4.0f};
+};
@@ -12,4 +12,17 @@ struct ALS_API FAlsViewSettings
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS")
 	uint8 bEnableListenServerNetworkSmoothing : 1 {true};
+
+	// If checked, the view rotation sent by the owning client to the server is compressed to 16 bits
+	// per axis (pitch and yaw only), otherwise it is sent as a full precision rotator.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS")
+	uint8 bCompressViewRotationRpc : 1 {false};
+
+	// The owning client sends the view rotation to the server only if it differs from the last sent view rotation by more than
+	// this angle, or if the max interval has elapsed since the last send. A value of 0 sends every change of the view rotation.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS", Meta = (ClampMin = 0, ClampMax = 10, ForceUnits = "deg"))
+	float ViewRotationRpcAngleThreshold{0.0f};
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS", Meta = (ClampMin = 0, ClampMax = 1, ForceUnits = "s"))
+	float ViewRotationRpcMaxInterval{0.1f};
 };
@@ -18,4 +18,8 @@ struct ALS_API FAlsRagdollingState
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, ForceUnits = "cm/s"))
 	float SpeedLimit{0.0f};
+
+	// Number of consecutive frames in which the ground trace was skipped because the scene query budget was exceeded.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS", Meta = (ClampMin = 0))
+	int32 DeferredGroundTracesCount{0};
 };
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "Containers/StaticArray.h"
+
+namespace AlsCorrectionRecords
+{
+	// Returns true if network corrections should be recorded, see the Als.Corrections.Record console
+	// variable. Always returns false in shipping builds, where the correction records are stripped.
+	ALS_API bool IsEnabled();
+}
+
+// Description of a single network correction of a character, recorded either on the server when the correction is sent,
+// or on the autonomous proxy when it is received. Used to find out what kind of moves are being corrected.
+struct ALS_API FAlsCorrectionRecord
+{
+	// World time at which the correction was sent or received.
+	double Time{0.0};
+
+	// Time stamp of the corrected move.
+	float MoveTimeStamp{0.0f};
+
+	FGameplayTag RotationMode;
+
+	FGameplayTag Stance;
+
+	FGameplayTag MaxAllowedGait;
+
+	// Forward and backward max speeds that the gait settings of the corrected move resolve to.
+	FVector2f MaxSpeeds{ForceInit};
+
+	// Server location minus client location.
+	FVector LocationDelta{ForceInit};
+
+	uint8 MovementMode{0};
+
+	bool bServer{false};
+
+	bool bRootMotionActive{false};
+
+	bool bMantlingRootMotionActive{false};
+
+	// Whether the corrected move was combined from several moves. Only known on the autonomous proxy.
+	bool bCombinedMove{false};
+
+public:
+	static const TCHAR* GetCsvHeader();
+
+	FString ToCsvRow() const;
+};
+
+// Fixed capacity ring buffer of correction records. If more corrections than the capacity
+// are recorded, the oldest ones are overwritten. Must only be used on the game thread.
+class ALS_API FAlsCorrectionRecordBuffer
+{
+public:
+	static constexpr auto Capacity{32};
+
+private:
+	TStaticArray<FAlsCorrectionRecord, Capacity> Records;
+
+	uint32 WriteCount{0};
+
+public:
+	void Record(const FAlsCorrectionRecord& NewRecord);
+
+	int32 Num() const;
+
+	void Reset();
+
+	// Calls the function for all recorded corrections, oldest first.
+	template <typename FunctionType>
+	void ForEach(FunctionType&& Function) const;
+};
+
+inline void FAlsCorrectionRecordBuffer::Record(const FAlsCorrectionRecord& NewRecord)
+{
+	Records[WriteCount % Capacity] = NewRecord;
+	WriteCount += 1;
+}
+
+inline int32 FAlsCorrectionRecordBuffer::Num() const
+{
+	return static_cast<int32>(FMath::Min(WriteCount, static_cast<uint32>(Capacity)));
+}
+
+inline void FAlsCorrectionRecordBuffer::Reset()
+{
+	WriteCount = 0;
+}
+
+template <typename FunctionType>
+void FAlsCorrectionRecordBuffer::ForEach(FunctionType&& Function) const
+{
+	const auto FirstIndex{WriteCount > Capacity ? WriteCount - Capacity : 0};
+
+	for (auto i{FirstIndex}; i < WriteCount; i++)
+	{
+		Function(Records[i % Capacity]);
+	}
+}
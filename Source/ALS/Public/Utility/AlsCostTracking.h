@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Containers/StaticArray.h"
+#include <atomic>
+
+class AAlsCharacter;
+class UWorld;
+
+enum class EAlsCostCategory : uint8
+{
+	// The whole character tick, including its subsections below.
+	CharacterTick,
+	View,
+	Locomotion,
+	Rotation,
+	Mantling,
+	Ragdolling,
+	AnimationGameThread,
+	AnimationWorkerThread,
+	// Scene queries issued while any of the above is being measured.
+	SceneQueries
+};
+
+namespace AlsCostTracking
+{
+	inline constexpr auto CategoriesCount{static_cast<int32>(EAlsCostCategory::SceneQueries) + 1};
+
+	// Returns true if the per-character cost tracking is enabled, see the Als.Cost.Enabled console variable.
+	ALS_API bool IsEnabled();
+
+	ALS_API const TCHAR* GetCategoryName(EAlsCostCategory Category);
+
+	// Fills the array with the characters of the world sorted by their total average cost in descending order.
+	ALS_API void GetCostliestCharacters(const UWorld* World, int32 MaxCount, TArray<const AAlsCharacter*>& Characters);
+}
+
+// Time spent on one character per cost category. The time of the current frame is accumulated from any thread and is
+// folded into the average at the beginning of the next character tick, so the averages lag behind by one frame.
+struct ALS_API FAlsCharacterCosts
+{
+	static constexpr auto AverageSmoothingFactor{0.05f};
+
+	TStaticArray<std::atomic<uint64>, AlsCostTracking::CategoriesCount> FrameCycles;
+
+	TStaticArray<float, AlsCostTracking::CategoriesCount> AverageMilliseconds{InPlace, 0.0f};
+
+public:
+	FAlsCharacterCosts();
+
+	void AddCycles(EAlsCostCategory Category, uint64 Cycles);
+
+	// Clears both the averages and the time accumulated in the current frame. Must be called on the game thread.
+	void Reset();
+
+	// Folds the time accumulated since the previous call into the averages. Must be called on the game thread.
+	void Refresh();
+
+	float GetAverageMilliseconds(EAlsCostCategory Category) const;
+
+	// Average time of the character tick and both animation updates.
+	float GetTotalAverageMilliseconds() const;
+};
+
+inline void FAlsCharacterCosts::AddCycles(const EAlsCostCategory Category, const uint64 Cycles)
+{
+	FrameCycles[static_cast<int32>(Category)].fetch_add(Cycles, std::memory_order_relaxed);
+}
+
+inline float FAlsCharacterCosts::GetAverageMilliseconds(const EAlsCostCategory Category) const
+{
+	return AverageMilliseconds[static_cast<int32>(Category)];
+}
+
+inline float FAlsCharacterCosts::GetTotalAverageMilliseconds() const
+{
+	return GetAverageMilliseconds(EAlsCostCategory::CharacterTick) +
+	       GetAverageMilliseconds(EAlsCostCategory::AnimationGameThread) +
+	       GetAverageMilliseconds(EAlsCostCategory::AnimationWorkerThread);
+}
+
+// Measures the time until the end of the scope and adds it to the costs. Does nothing if the cost tracking is disabled. While
+// the scope is active, the costs are also available through GetThreadCosts(), so that nested code, such as scene queries,
+// can attribute its time to the character without having to know about it.
+class ALS_API FAlsCostScope
+{
+private:
+	FAlsCharacterCosts* Costs{nullptr};
+
+	FAlsCharacterCosts* PreviousThreadCosts{nullptr};
+
+	EAlsCostCategory Category{EAlsCostCategory::CharacterTick};
+
+	uint64 StartCycles{0};
+
+public:
+	FAlsCostScope(FAlsCharacterCosts* NewCosts, EAlsCostCategory NewCategory);
+
+	~FAlsCostScope();
+
+	FAlsCostScope(const FAlsCostScope&) = delete;
+
+	FAlsCostScope& operator=(const FAlsCostScope&) = delete;
+
+	// Returns the costs of the innermost active scope on the calling thread, or nullptr if there is none.
+	static FAlsCharacterCosts* GetThreadCosts();
+};
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "CoreGlobals.h"
+#include "Containers/Array.h"
+#include "Math/Vector.h"
+
+class UCurveFloat;
+
+// Structure of arrays storage of the hot per frame locomotion state of all characters registered in
+// UAlsCharacterTickSubsystem. Each character holds its index in the storage, so batched updates only iterate
+// over contiguous arrays instead of hopping between character actors scattered across memory.
+struct ALS_API FAlsCrowdStorage
+{
+	static constexpr auto HasSpeedThreshold{1.0f};
+
+	enum EFlags : uint8
+	{
+		HasInput = 1 << 0,
+		HasVelocity = 1 << 1,
+		Moving = 1 << 2
+	};
+
+	// Frames in which the elements were last prepared. The values of an element are only valid during this frame,
+	// so that characters registered after the preparation, or skipped by it, fall back to the serial refresh.
+	TArray<uint64> FrameNumbers;
+
+	// Gathered from the characters.
+
+	TArray<FVector> Velocities;
+
+	TArray<FVector> InputDirections;
+
+	TArray<float> MovingSpeedThresholds;
+
+	// Values of the rotation yaw speed and rotation yaw offset animation curves.
+
+	TArray<float> RotationYawSpeeds;
+
+	TArray<float> RotationYawOffsets;
+
+	// Gait amount and rotation interpolation speed curve of the character movement component that the rotation
+	// interpolation speed was evaluated for. Stored so that the character can check that they haven't changed since
+	// then, for example, because of a rotation mode or stance change. The curves are only used for this comparison.
+
+	TArray<float> GaitAmounts;
+
+	TArray<const UCurveFloat*> RotationInterpolationSpeedCurves;
+
+	TArray<float> RotationInterpolationSpeeds;
+
+	// Calculated from the gathered values.
+
+	TArray<float> Speeds;
+
+	TArray<float> VelocityYawAngles;
+
+	TArray<float> InputYawAngles;
+
+	TArray<uint8> Flags;
+
+public:
+	int32 Num() const;
+
+	bool IsUpToDate(int32 Index) const;
+
+	int32 Add();
+
+	// Removes the element by moving the last element in its place.
+	void RemoveAtSwap(int32 Index);
+
+	void Reset();
+
+	// Calculates the derived values of the element from its gathered values and marks the element as prepared in the current frame.
+	void Calculate(int32 Index);
+
+	bool HasInput(int32 Index) const;
+
+	bool HasVelocity(int32 Index) const;
+
+	bool IsMoving(int32 Index) const;
+
+	// Returns the prepared rotation interpolation speed if it was evaluated for the given curve and gait amount.
+	bool TryGetRotationInterpolationSpeed(int32 Index, const UCurveFloat* Curve, float GaitAmount, float& InterpolationSpeed) const;
+};
+
+inline int32 FAlsCrowdStorage::Num() const
+{
+	return Velocities.Num();
+}
+
+inline bool FAlsCrowdStorage::IsUpToDate(const int32 Index) const
+{
+	return FrameNumbers.IsValidIndex(Index) && FrameNumbers[Index] == GFrameCounter;
+}
+
+inline bool FAlsCrowdStorage::HasInput(const int32 Index) const
+{
+	return (Flags[Index] & EFlags::HasInput) != 0;
+}
+
+inline bool FAlsCrowdStorage::HasVelocity(const int32 Index) const
+{
+	return (Flags[Index] & EFlags::HasVelocity) != 0;
+}
+
+inline bool FAlsCrowdStorage::IsMoving(const int32 Index) const
+{
+	return (Flags[Index] & EFlags::Moving) != 0;
+}
+
+inline bool FAlsCrowdStorage::TryGetRotationInterpolationSpeed(const int32 Index, const UCurveFloat* Curve,
+                                                                const float GaitAmount, float& InterpolationSpeed) const
+{
+	if (Curve == nullptr || RotationInterpolationSpeedCurves[Index] != Curve || GaitAmounts[Index] != GaitAmount)
+	{
+		return false;
+	}
+
+	InterpolationSpeed = RotationInterpolationSpeeds[Index];
+	return true;
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "Containers/StaticArray.h"
+#include <atomic>
+#include <type_traits>
+
+class FOutputDevice;
+class UWorld;
+
+enum class EAlsDebugShapeType : uint8
+{
+	LineTrace,
+	SweepSphere,
+	SweepCapsule
+};
+
+// Plain data description of a single debug trace, so it can be recorded without allocations from any thread.
+struct ALS_API FAlsDebugShape
+{
+	FVector Start{ForceInit};
+
+	FVector End{ForceInit};
+
+	FVector HitLocation{ForceInit};
+
+	FVector HitImpactPoint{ForceInit};
+
+	FRotator Rotation{ForceInit};
+
+	FLinearColor TraceColor{ForceInit};
+
+	FLinearColor HitColor{ForceInit};
+
+	float Radius{0.0f};
+
+	float HalfHeight{0.0f};
+
+	float Duration{0.0f};
+
+	EAlsDebugShapeType Type{EAlsDebugShapeType::LineTrace};
+
+	bool bHit{false};
+
+public:
+	void Draw(const UWorld* World) const;
+
+	FString ToString() const;
+};
+
+static_assert(std::is_trivially_copyable_v<FAlsDebugShape>);
+
+// Fixed capacity ring buffer of debug shapes. Shapes are recorded lock-free from a worker thread during the
+// animation update and drained on the game thread. Draining only draws the shapes recorded since the previous
+// drain, the last Capacity shapes are kept so that they can be dumped later. If more shapes than the capacity are
+// recorded, the oldest ones are overwritten. Writers are not synchronized with draining, so it should only be
+// drained when no worker thread can record into the buffer, for example, in UAnimInstance::NativePostUpdateAnimation().
+class ALS_API FAlsDebugShapeBuffer
+{
+public:
+	static constexpr auto Capacity{32};
+
+private:
+	TStaticArray<FAlsDebugShape, Capacity> Shapes;
+
+	std::atomic<uint32> WriteCount{0};
+
+	// Value of the write count at the time of the last drain. Only accessed on the game thread.
+	uint32 DrainedCount{0};
+
+public:
+	void Record(const FAlsDebugShape& Shape);
+
+	int32 Num() const;
+
+	// Draws the shapes recorded since the previous drain, oldest first.
+	void Drain(const UWorld* World);
+
+	void Reset();
+
+	// Writes the last recorded shapes to the output device, oldest first, including the already drained ones.
+	void Dump(FOutputDevice& Output) const;
+
+private:
+	template <typename FunctionType>
+	void ForEach(uint32 StartCount, FunctionType&& Function) const;
+};
+
+inline void FAlsDebugShapeBuffer::Record(const FAlsDebugShape& Shape)
+{
+	const auto Index{WriteCount.fetch_add(1, std::memory_order_relaxed)};
+
+	Shapes[Index % Capacity] = Shape;
+}
+
+inline int32 FAlsDebugShapeBuffer::Num() const
+{
+	return static_cast<int32>(FMath::Min(WriteCount.load(std::memory_order_acquire), static_cast<uint32>(Capacity)));
+}
+
+inline void FAlsDebugShapeBuffer::Reset()
+{
+	WriteCount.store(0, std::memory_order_release);
+	DrainedCount = 0;
+}
+
+template <typename FunctionType>
+void FAlsDebugShapeBuffer::ForEach(const uint32 StartCount, FunctionType&& Function) const
+{
+	const auto Count{WriteCount.load(std::memory_order_acquire)};
+	const auto FirstIndex{FMath::Max(StartCount, Count > Capacity ? Count - Capacity : 0)};
+
+	for (auto i{FirstIndex}; i < Count; i++)
+	{
+		Function(Shapes[i % Capacity]);
+	}
+}
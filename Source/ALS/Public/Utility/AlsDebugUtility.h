@@ -15,6 +15,7 @@ public:
 	static constexpr auto DrawCircleSidesCount{16};
 
 public:
+	// Always returns false in builds without debug drawing, so the debug hooks that rely on it are stripped there.
 	UFUNCTION(BlueprintPure, Category = "ALS|Debug Utility",
 		Meta = (DefaultToSelf = "Actor", AutoCreateRefTerm = "DisplayName", ReturnDisplayName = "Value"))
 	static bool ShouldDisplayDebugForActor(const AActor* Actor, const FName& DisplayName);
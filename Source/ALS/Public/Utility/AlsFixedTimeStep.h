@@ -0,0 +1,54 @@
+#pragma once
+
+#include "HAL/Platform.h"
+
+// Splits the frame delta time into a whole number of fixed time steps followed by one partial step for the remaining
+// time. Integrating with these steps bounds the step size regardless of the frame rate, so the result at low frame rates
+// matches the one at high frame rates, while the state still advances on every frame, even if the frame delta time is
+// shorter than the time step.
+struct ALS_API FAlsFixedTimeStep
+{
+	float TimeStep{0.0f};
+
+	// Time left after the whole steps of the current frame, integrated as one partial step.
+	float Remainder{0.0f};
+
+	// Number of whole steps to take in the current frame.
+	int32 SubstepsCount{0};
+
+public:
+	bool IsEnabled() const;
+
+	// Splits the frame delta time into steps. A time step of 0 disables the fixed time step.
+	void Advance(float DeltaTime, float NewTimeStep, int32 MaxSubstepsCount);
+
+	// Calls the function once with the frame delta time if the fixed time step is disabled, otherwise calls
+	// it once for each whole step of the current frame and then once more for the remaining time, if any.
+	template <typename FunctionType>
+	void Integrate(float DeltaTime, FunctionType&& Function) const;
+};
+
+inline bool FAlsFixedTimeStep::IsEnabled() const
+{
+	return TimeStep > 0.0f;
+}
+
+template <typename FunctionType>
+void FAlsFixedTimeStep::Integrate(const float DeltaTime, FunctionType&& Function) const
+{
+	if (!IsEnabled())
+	{
+		Function(DeltaTime);
+		return;
+	}
+
+	for (auto i{0}; i < SubstepsCount; i++)
+	{
+		Function(TimeStep);
+	}
+
+	if (Remainder > 0.0f)
+	{
+		Function(Remainder);
+	}
+}
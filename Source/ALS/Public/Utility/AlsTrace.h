@@ -0,0 +1,38 @@
+﻿#pragma once
+
+#include "Trace/Trace.h"
+
+#define ALS_TRACE_ENABLED (UE_TRACE_ENABLED && !UE_BUILD_SHIPPING)
+
+class AActor;
+
+enum class EAlsTraceEventType : uint8
+{
+	LocomotionMode,
+	RotationMode,
+	Stance,
+	Gait,
+	LocomotionAction,
+	TurnInPlace,
+	Transition,
+	FootLockEngaged,
+	FootLockReleased
+};
+
+#if ALS_TRACE_ENABLED
+// Enable with -trace=Als or Trace.Enable Als to record character state changes as Als.StateChanged events.
+// Also enable the Bookmark channel to see them as bookmarks on the timeline of Unreal Insights.
+UE_TRACE_CHANNEL_EXTERN(AlsChannel, ALS_API)
+
+namespace AlsTrace
+{
+	// Safe to call from any thread. Does nothing unless the trace channel is enabled. To keep the event cheap, it only contains
+	// the unique id of the actor and the comparison index and number of the value name. The actor names and the value name
+	// strings are traced once by the separate Als.ActorName and Als.ValueName important events, which every trace session receives.
+	ALS_API void TraceStateChanged(const AActor* Actor, EAlsTraceEventType Type, const FName& Value);
+}
+
+#define ALS_TRACE_STATE_CHANGED(Actor, Type, Value) AlsTrace::TraceStateChanged(Actor, Type, Value)
+#else
+#define ALS_TRACE_STATE_CHANGED(Actor, Type, Value)
+#endif
@@ -1,12 +1,15 @@
 #pragma once
 
 #include "Kismet/BlueprintFunctionLibrary.h"
+#include "ProfilingDebugging/CsvProfiler.h"
 #include "AlsUtility.generated.h"
 
 struct FBasedMovementInfo;
 
 DECLARE_STATS_GROUP(TEXT("Als"), STATGROUP_Als, STATCAT_Advanced)
 
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(ALS_API, Als);
+
 UCLASS()
 class ALS_API UAlsUtility : public UBlueprintFunctionLibrary
 {
@@ -1,6 +1,7 @@
 #include "AlsCameraComponent.h"
 
 #include "AlsCameraSettings.h"
+#include "AlsSceneQuerySubsystem.h"
 #include "DrawDebugHelpers.h"
 #include "Animation/AnimInstance.h"
 #include "Engine/OverlapResult.h"
@@ -417,9 +418,12 @@ FVector UAlsCameraComponent::CalculateCameraTrace(const FVector& CameraTargetLoc
 
 	auto TraceResult{TraceEnd};
 
+	CSV_CUSTOM_STAT(Als, CameraQueries, 1, ECsvCustomStatOp::Accumulate);
+
 	FHitResult Hit;
-	if (GetWorld()->SweepSingleByChannel(Hit, TraceStart, TraceEnd, FQuat::Identity, Settings->ThirdPerson.TraceChannel,
-	                                     CollisionShape, {MainTraceTag, false, GetOwner()}))
+	if (UAlsSceneQuerySubsystem::SweepSingleByChannel(GetWorld(), EAlsSceneQuerySource::Camera, Hit, TraceStart, TraceEnd,
+	                                                  FQuat::Identity, Settings->ThirdPerson.TraceChannel,
+	                                                  CollisionShape, {MainTraceTag, false, GetOwner()}))
 	{
 		if (!Hit.bStartPenetrating)
 		{
@@ -429,8 +433,11 @@ FVector UAlsCameraComponent::CalculateCameraTrace(const FVector& CameraTargetLoc
 		{
 			static const FName AdjustedTraceTag{FString::Printf(TEXT("%hs (Adjusted Trace)"), __FUNCTION__)};
 
-			GetWorld()->SweepSingleByChannel(Hit, TraceStart, TraceEnd, FQuat::Identity, Settings->ThirdPerson.TraceChannel,
-			                                 CollisionShape, {AdjustedTraceTag, false, GetOwner()});
+			UAlsSceneQuerySubsystem::SweepSingleByChannel(GetWorld(), EAlsSceneQuerySource::Camera, Hit, TraceStart, TraceEnd,
+			                                              FQuat::Identity, Settings->ThirdPerson.TraceChannel,
+			                                              CollisionShape, {AdjustedTraceTag, false, GetOwner()});
+
+			CSV_CUSTOM_STAT(Als, CameraQueries, 1, ECsvCustomStatOp::Accumulate);
 			if (Hit.IsValidBlockingHit())
 			{
 				TraceResult = Hit.Location;
@@ -495,8 +502,9 @@ bool UAlsCameraComponent::TryAdjustLocationBlockedByGeometry(FVector& Location,
 
 	static const FName OverlapMultiTraceTag{FString::Printf(TEXT("%hs (Overlap Multi)"), __FUNCTION__)};
 
-	if (!GetWorld()->OverlapMultiByChannel(Overlaps, Location, FQuat::Identity, Settings->ThirdPerson.TraceChannel,
-	                                       CollisionShape, {OverlapMultiTraceTag, false, GetOwner()}))
+	if (!UAlsSceneQuerySubsystem::OverlapMultiByChannel(GetWorld(), EAlsSceneQuerySource::Camera, Overlaps, Location,
+	                                                    FQuat::Identity, Settings->ThirdPerson.TraceChannel,
+	                                                    CollisionShape, {OverlapMultiTraceTag, false, GetOwner()}))
 	{
 		return false;
 	}
@@ -554,7 +562,9 @@ bool UAlsCameraComponent::TryAdjustLocationBlockedByGeometry(FVector& Location,
 
 	static const FName FreeSpaceTraceTag{FString::Printf(TEXT("%hs (Free Space Overlap)"), __FUNCTION__)};
 
-	return !GetWorld()->OverlapBlockingTestByChannel(Location, FQuat::Identity, Settings->ThirdPerson.TraceChannel,
-	                                                 FCollisionShape::MakeSphere(Settings->ThirdPerson.TraceRadius * MeshScale),
-	                                                 {FreeSpaceTraceTag, false, GetOwner()});
+	return !UAlsSceneQuerySubsystem::OverlapBlockingTestByChannel(GetWorld(), EAlsSceneQuerySource::Camera, Location,
+	                                                              FQuat::Identity, Settings->ThirdPerson.TraceChannel,
+	                                                              FCollisionShape::MakeSphere(
+		                                                              Settings->ThirdPerson.TraceRadius * MeshScale),
+	                                                              {FreeSpaceTraceTag, false, GetOwner()});
 }
@@ -17,7 +17,7 @@ public class ALSExtras : ModuleRules
 
 		PrivateDependencyModuleNames.AddRange(new[]
 		{
-			"EnhancedInput", "ALSCamera"
+			"EnhancedInput", "RenderCore", "ALSCamera"
 		});
 	}
 }
\ No newline at end of file
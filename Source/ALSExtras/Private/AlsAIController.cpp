@@ -11,9 +11,89 @@ void AAlsAIController::OnPossess(APawn* NewPawn)
 {
 	Super::OnPossess(NewPawn);
 
+	// Spread the control rotation updates of controllers evenly over the update interval.
+
+	const auto UpdateGroup{static_cast<int32>(GetUniqueID() % ControlRotationUpdateGroupsCount)};
+
+	ControlRotationUpdateTimeRemaining = ControlRotationUpdateInterval * UpdateGroup / ControlRotationUpdateGroupsCount;
+	ControlRotationUpdateDeltaTime = 0.0f;
+
 	RunBehaviorTree(BehaviorTree);
 }
 
+void AAlsAIController::UpdateControlRotation(const float DeltaTime, const bool bUpdatePawn)
+{
+	if (ControlRotationUpdateInterval <= 0.0f)
+	{
+		Super::UpdateControlRotation(DeltaTime, bUpdatePawn);
+		return;
+	}
+
+	ControlRotationUpdateTimeRemaining -= DeltaTime;
+	ControlRotationUpdateDeltaTime += DeltaTime;
+
+	if (ControlRotationUpdateTimeRemaining > 0.0f)
+	{
+		return;
+	}
+
+	// Don't let the overshoot accumulate after hitches, otherwise several updates in a row would happen. In
+	// that case, start a whole new interval, while small overshoots are carried over to keep the update phase.
+
+	if (ControlRotationUpdateTimeRemaining < -ControlRotationUpdateInterval)
+	{
+		ControlRotationUpdateTimeRemaining = ControlRotationUpdateInterval;
+	}
+	else
+	{
+		ControlRotationUpdateTimeRemaining += ControlRotationUpdateInterval;
+	}
+
+	Super::UpdateControlRotation(ControlRotationUpdateDeltaTime, bUpdatePawn);
+
+	ControlRotationUpdateDeltaTime = 0.0f;
+}
+
+void AAlsAIController::SetFocalPoint(const FVector NewFocus, const EAIFocusPriority::Type InPriority)
+{
+	const auto* PreviousFocusActor{GetFocusActor()};
+	const auto PreviousFocalPoint{GetFocalPoint()};
+
+	Super::SetFocalPoint(NewFocus, InPriority);
+
+	ForceControlRotationUpdateIfFocusChanged(PreviousFocusActor, PreviousFocalPoint);
+}
+
+void AAlsAIController::SetFocus(AActor* NewFocus, const EAIFocusPriority::Type InPriority)
+{
+	const auto* PreviousFocusActor{GetFocusActor()};
+	const auto PreviousFocalPoint{GetFocalPoint()};
+
+	Super::SetFocus(NewFocus, InPriority);
+
+	ForceControlRotationUpdateIfFocusChanged(PreviousFocusActor, PreviousFocalPoint);
+}
+
+void AAlsAIController::ClearFocus(const EAIFocusPriority::Type InPriority)
+{
+	const auto* PreviousFocusActor{GetFocusActor()};
+	const auto PreviousFocalPoint{GetFocalPoint()};
+
+	Super::ClearFocus(InPriority);
+
+	ForceControlRotationUpdateIfFocusChanged(PreviousFocusActor, PreviousFocalPoint);
+}
+
+void AAlsAIController::ForceControlRotationUpdateIfFocusChanged(const AActor* PreviousFocusActor, const FVector& PreviousFocalPoint)
+{
+	// Only the focus with the highest priority affects the control rotation, so changes of lower priority ones are ignored.
+
+	if (GetFocusActor() != PreviousFocusActor || !GetFocalPoint().Equals(PreviousFocalPoint))
+	{
+		ForceControlRotationUpdate();
+	}
+}
+
 FVector AAlsAIController::GetFocalPointOnActor(const AActor* Actor) const
 {
 	const auto* FocusedPawn{Cast<APawn>(Actor)};
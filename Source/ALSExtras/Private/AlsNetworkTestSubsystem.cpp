@@ -0,0 +1,363 @@
+#include "AlsNetworkTestSubsystem.h"
+
+#include "AlsCharacter.h"
+#include "AlsCharacterMovementComponent.h"
+#include "AlsTestUtility.h"
+#include "EngineUtils.h"
+#include "Engine/Engine.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Parse.h"
+#include "Utility/AlsGameplayTags.h"
+#include "Utility/AlsLog.h"
+#include "Utility/AlsUtility.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsNetworkTestSubsystem)
+
+namespace AlsNetworkTest
+{
+#if ALLOW_CONSOLE
+	void StartNetworkTest(const TArray<FString>& Arguments)
+	{
+		const auto CommandLine{FString::Join(Arguments, TEXT(" "))};
+
+		FAlsNetworkTestSettings Settings;
+
+		FParse::Value(*CommandLine, TEXT("Duration="), Settings.Duration);
+		FParse::Value(*CommandLine, TEXT("Loss="), Settings.PacketLossPercentage);
+		FParse::Value(*CommandLine, TEXT("Lag="), Settings.PacketLagMilliseconds);
+		FParse::Value(*CommandLine, TEXT("LagVariance="), Settings.PacketLagVarianceMilliseconds);
+
+		auto bQuitWhenFinished{false};
+		FParse::Bool(*CommandLine, TEXT("Quit="), bQuitWhenFinished);
+		Settings.bQuitWhenFinished = bQuitWhenFinished;
+
+		auto bStarted{false};
+
+		for (const auto& WorldContext : GEngine->GetWorldContexts())
+		{
+			auto* Subsystem{UAlsNetworkTestSubsystem::Get(WorldContext.World())};
+			if (IsValid(Subsystem))
+			{
+				bStarted |= Subsystem->Start(Settings);
+			}
+		}
+
+		if (!bStarted)
+		{
+			UE_LOG(LogAls, Warning, TEXT("The network test can only be run in game or PIE worlds."));
+		}
+	}
+
+	FAutoConsoleCommandWithArgs StartCommand{
+		TEXT("Als.NetworkTest.Start"),
+		TEXT("Starts the ALS network test in all worlds of the process. ")
+		TEXT("Arguments: [Duration=60] [Loss=5] [Lag=100] [LagVariance=20] [Quit=0]."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&StartNetworkTest)
+	};
+
+	FAutoConsoleCommand StopCommand{
+		TEXT("Als.NetworkTest.Stop"),
+		TEXT("Stops the ALS network test in all worlds of the process and prints the summary."),
+		FConsoleCommandDelegate::CreateLambda([]
+		{
+			for (const auto& WorldContext : GEngine->GetWorldContexts())
+			{
+				auto* Subsystem{UAlsNetworkTestSubsystem::Get(WorldContext.World())};
+				if (IsValid(Subsystem))
+				{
+					Subsystem->Stop();
+				}
+			}
+		})
+	};
+#endif
+
+	const TCHAR* GetNetModeName(const ENetMode NetMode)
+	{
+		switch (NetMode)
+		{
+			case NM_Standalone:
+				return TEXT("Standalone");
+
+			case NM_DedicatedServer:
+				return TEXT("Dedicated Server");
+
+			case NM_ListenServer:
+				return TEXT("Listen Server");
+
+			case NM_Client:
+				return TEXT("Client");
+
+			default:
+				return TEXT("Unknown");
+		}
+	}
+}
+
+UAlsNetworkTestSubsystem* UAlsNetworkTestSubsystem::Get(const UWorld* World)
+{
+	return IsValid(World) ? World->GetSubsystem<UAlsNetworkTestSubsystem>() : nullptr;
+}
+
+void UAlsNetworkTestSubsystem::Deinitialize()
+{
+	// Print the summary even if the world is torn down before the test is complete, for example, when another
+	// world of the same play in editor session ends the session once its own test is complete.
+
+	Stop();
+
+	Super::Deinitialize();
+}
+
+void UAlsNetworkTestSubsystem::Tick(const float DeltaTime)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("UAlsNetworkTestSubsystem::Tick"), STAT_UAlsNetworkTestSubsystem_Tick, STATGROUP_Als)
+	TRACE_CPUPROFILER_EVENT_SCOPE(__FUNCTION__);
+
+	Super::Tick(DeltaTime);
+
+	if (!bRunning)
+	{
+		return;
+	}
+
+	const auto PreviousTime{Time};
+	Time += DeltaTime;
+
+	RefreshLocalCharacters(PreviousTime);
+
+	if (Time >= Settings.Duration)
+	{
+		Stop();
+
+		if (Settings.bQuitWhenFinished)
+		{
+			GEngine->Exec(GetWorld(), TEXT("Quit"));
+		}
+	}
+}
+
+TStatId UAlsNetworkTestSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAlsNetworkTestSubsystem, STATGROUP_Tickables)
+}
+
+bool UAlsNetworkTestSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UAlsNetworkTestSubsystem::Start(const FAlsNetworkTestSettings& NewSettings)
+{
+	if (bRunning || GetWorld()->GetNetMode() == NM_Standalone)
+	{
+		return false;
+	}
+
+	Settings = NewSettings;
+
+	bRunning = true;
+	Time = 0.0f;
+
+	PreviousPacketSimulation = SetPacketSimulation({
+		Settings.PacketLossPercentage, Settings.PacketLagMilliseconds, Settings.PacketLagVarianceMilliseconds
+	});
+
+	GetTransferredBytes(InitialInBytes, InitialOutBytes);
+	ResetCorrectionStatistics();
+
+	UE_LOG(LogAls, Log, TEXT("Started the network test on %s with %d%% packet loss and %d ms packet lag."),
+	       AlsNetworkTest::GetNetModeName(GetWorld()->GetNetMode()), Settings.PacketLossPercentage, Settings.PacketLagMilliseconds);
+
+	return true;
+}
+
+void UAlsNetworkTestSubsystem::Stop()
+{
+	if (!bRunning)
+	{
+		return;
+	}
+
+	bRunning = false;
+
+	PrintSummary();
+	SetPacketSimulation(PreviousPacketSimulation);
+}
+
+UAlsNetworkTestSubsystem::FPacketSimulation UAlsNetworkTestSubsystem::SetPacketSimulation(
+	const FPacketSimulation& NewPacketSimulation) const
+{
+	FPacketSimulation PreviousSimulation;
+
+#if DO_ENABLE_NET_TEST
+	auto* NetDriver{GetWorld()->GetNetDriver()};
+	if (!IsValid(NetDriver))
+	{
+		return PreviousSimulation;
+	}
+
+	auto PacketSimulationSettings{NetDriver->PacketSimulationSettings};
+
+	PreviousSimulation.PacketLossPercentage = PacketSimulationSettings.PktLoss;
+	PreviousSimulation.PacketLagMilliseconds = PacketSimulationSettings.PktLag;
+	PreviousSimulation.PacketLagVarianceMilliseconds = PacketSimulationSettings.PktLagVariance;
+
+	PacketSimulationSettings.PktLoss = NewPacketSimulation.PacketLossPercentage;
+	PacketSimulationSettings.PktLag = NewPacketSimulation.PacketLagMilliseconds;
+	PacketSimulationSettings.PktLagVariance = NewPacketSimulation.PacketLagVarianceMilliseconds;
+
+	NetDriver->SetPacketSimulationSettings(PacketSimulationSettings);
+#else
+	UE_LOG(LogAls, Warning, TEXT("Packet simulation is not available in this build configuration."));
+#endif
+
+	return PreviousSimulation;
+}
+
+void UAlsNetworkTestSubsystem::GetTransferredBytes(int64& InBytes, int64& OutBytes) const
+{
+	InBytes = 0;
+	OutBytes = 0;
+
+	const auto* NetDriver{GetWorld()->GetNetDriver()};
+	if (!IsValid(NetDriver))
+	{
+		return;
+	}
+
+	if (IsValid(NetDriver->ServerConnection))
+	{
+		InBytes = NetDriver->ServerConnection->InTotalBytes;
+		OutBytes = NetDriver->ServerConnection->OutTotalBytes;
+		return;
+	}
+
+	for (const auto* Connection : NetDriver->ClientConnections)
+	{
+		if (IsValid(Connection))
+		{
+			InBytes += Connection->InTotalBytes;
+			OutBytes += Connection->OutTotalBytes;
+		}
+	}
+}
+
+void UAlsNetworkTestSubsystem::ResetCorrectionStatistics() const
+{
+	for (const auto* Character : TActorRange<AAlsCharacter>{GetWorld()})
+	{
+		auto* CharacterMovement{Cast<UAlsCharacterMovementComponent>(Character->GetCharacterMovement())};
+		if (IsValid(CharacterMovement))
+		{
+			CharacterMovement->ResetCorrectionStatistics();
+		}
+	}
+}
+
+void UAlsNetworkTestSubsystem::RefreshLocalCharacters(const float PreviousTime) const
+{
+	static constexpr auto TurnSpeed{30.0f};
+	static constexpr auto RotationModeChangeInterval{2.0f};
+	static constexpr auto StanceChangeInterval{3.0f};
+	static constexpr auto GaitChangeInterval{2.5f};
+	static constexpr auto JumpInterval{4.0f};
+	static constexpr auto MantlingInterval{0.5f};
+
+	for (auto Iterator{GetWorld()->GetPlayerControllerIterator()}; Iterator; ++Iterator)
+	{
+		auto* Player{Iterator->Get()};
+		auto* Character{IsValid(Player) && Player->IsLocalController() ? Cast<AAlsCharacter>(Player->GetPawn()) : nullptr};
+
+		if (!IsValid(Character))
+		{
+			continue;
+		}
+
+		// Turn slowly and keep moving forward, so that the view direction rotation mode changes the movement direction.
+
+		const auto ControlYawAngle{Player->GetControlRotation().Yaw + TurnSpeed * (Time - PreviousTime)};
+
+		Player->SetControlRotation({0.0f, FRotator::NormalizeAxis(ControlYawAngle), 0.0f});
+
+		Character->AddMovementInput(Character->GetActorForwardVector());
+
+		if (AlsTestUtility::HasPassed(PreviousTime, Time, RotationModeChangeInterval, 0.0f))
+		{
+			Character->SetDesiredRotationMode(Character->GetDesiredRotationMode() == AlsRotationModeTags::VelocityDirection
+				                                  ? AlsRotationModeTags::ViewDirection
+				                                  : AlsRotationModeTags::VelocityDirection);
+		}
+
+		if (AlsTestUtility::HasPassed(PreviousTime, Time, StanceChangeInterval, 0.0f))
+		{
+			Character->SetDesiredStance(Character->GetDesiredStance() == AlsStanceTags::Standing
+				                            ? AlsStanceTags::Crouching
+				                            : AlsStanceTags::Standing);
+		}
+
+		if (AlsTestUtility::HasPassed(PreviousTime, Time, GaitChangeInterval, 0.0f))
+		{
+			const auto& DesiredGait{Character->GetDesiredGait()};
+
+			Character->SetDesiredGait(DesiredGait == AlsGaitTags::Walking
+				                          ? AlsGaitTags::Running
+				                          : DesiredGait == AlsGaitTags::Running
+				                          ? AlsGaitTags::Sprinting
+				                          : AlsGaitTags::Walking);
+		}
+
+		if (AlsTestUtility::HasPassed(PreviousTime, Time, JumpInterval, 0.0f))
+		{
+			Character->Jump();
+		}
+		else if (AlsTestUtility::HasPassed(PreviousTime, Time, MantlingInterval, 0.0f))
+		{
+			Character->StartMantlingGrounded();
+		}
+	}
+}
+
+void UAlsNetworkTestSubsystem::PrintSummary() const
+{
+	FAlsNetworkCorrectionStatistics Statistics;
+	auto CharactersCount{0};
+
+	for (const auto* Character : TActorRange<AAlsCharacter>{GetWorld()})
+	{
+		const auto* CharacterMovement{Cast<UAlsCharacterMovementComponent>(Character->GetCharacterMovement())};
+		if (!IsValid(CharacterMovement))
+		{
+			continue;
+		}
+
+		const auto& CharacterStatistics{CharacterMovement->GetCorrectionStatistics()};
+
+		Statistics.CorrectionsCount += CharacterStatistics.CorrectionsCount;
+		Statistics.TotalCorrectionDistance += CharacterStatistics.TotalCorrectionDistance;
+		Statistics.MaxCorrectionDistance = FMath::Max(Statistics.MaxCorrectionDistance, CharacterStatistics.MaxCorrectionDistance);
+
+		CharactersCount += 1;
+	}
+
+	int64 InBytes;
+	int64 OutBytes;
+	GetTransferredBytes(InBytes, OutBytes);
+
+	const auto Duration{FMath::Max(Time, UE_KINDA_SMALL_NUMBER)};
+	const auto* NetModeName{AlsNetworkTest::GetNetModeName(GetWorld()->GetNetMode())};
+
+	UE_LOG(LogAls, Display, TEXT("ALS network test summary (%s): %.1f s, %d characters, %d%% packet loss, %d ms packet lag."),
+	       NetModeName, Time, CharactersCount, Settings.PacketLossPercentage, Settings.PacketLagMilliseconds);
+
+	UE_LOG(LogAls, Display, TEXT("ALS network test summary (%s): %d corrections (%.2f per second), distance average %.2f, max %.2f."),
+	       NetModeName, Statistics.CorrectionsCount, Statistics.CorrectionsCount / Duration,
+	       Statistics.GetAverageCorrectionDistance(), Statistics.MaxCorrectionDistance);
+
+	UE_LOG(LogAls, Display, TEXT("ALS network test summary (%s): %.2f KB/s in, %.2f KB/s out."),
+	       NetModeName, (InBytes - InitialInBytes) / 1024.0f / Duration, (OutBytes - InitialOutBytes) / 1024.0f / Duration);
+}
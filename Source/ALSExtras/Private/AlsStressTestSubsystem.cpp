@@ -0,0 +1,624 @@
+#include "AlsStressTestSubsystem.h"
+
+#include "AIController.h"
+#include "AlsCharacter.h"
+#include "AlsTestUtility.h"
+#include "RenderCore.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Utility/AlsCostTracking.h"
+#include "Utility/AlsGameplayTags.h"
+#include "Utility/AlsLog.h"
+#include "Utility/AlsMacros.h"
+#include "Utility/AlsUtility.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsStressTestSubsystem)
+
+namespace AlsStressTest
+{
+#if ALLOW_CONSOLE
+	void StartStressTest(const TArray<FString>& Arguments, UWorld* World)
+	{
+		auto* Subsystem{UAlsStressTestSubsystem::Get(World)};
+		if (!IsValid(Subsystem))
+		{
+			UE_LOG(LogAls, Warning, TEXT("The stress test can only be run in game or PIE worlds."));
+			return;
+		}
+
+		const auto CommandLine{FString::Join(Arguments, TEXT(" "))};
+
+		FAlsStressTestSettings Settings;
+
+		FString ScenarioName;
+		if (FParse::Value(*CommandLine, TEXT("Scenario="), ScenarioName))
+		{
+			const auto Scenario{StaticEnum<EAlsStressTestScenario>()->GetValueByNameString(ScenarioName)};
+			if (Scenario == INDEX_NONE)
+			{
+				UE_LOG(LogAls, Warning, TEXT("Unknown stress test scenario: %s."), *ScenarioName);
+				return;
+			}
+
+			Settings.Scenario = static_cast<EAlsStressTestScenario>(Scenario);
+		}
+
+		FString ClassPath;
+		if (FParse::Value(*CommandLine, TEXT("Class="), ClassPath))
+		{
+			Settings.CharacterClass = LoadClass<AAlsCharacter>(nullptr, *ClassPath);
+		}
+		else
+		{
+			// Use the class of the player character by default, since it is most likely properly set up.
+
+			const auto* Player{World->GetFirstPlayerController()};
+			const auto* PlayerCharacter{IsValid(Player) ? Cast<AAlsCharacter>(Player->GetPawn()) : nullptr};
+
+			if (IsValid(PlayerCharacter))
+			{
+				Settings.CharacterClass = PlayerCharacter->GetClass();
+			}
+		}
+
+		FParse::Value(*CommandLine, TEXT("Count="), Settings.CharactersCount);
+		FParse::Value(*CommandLine, TEXT("Spacing="), Settings.Spacing);
+		FParse::Value(*CommandLine, TEXT("Duration="), Settings.Duration);
+		FParse::Value(*CommandLine, TEXT("WarmUp="), Settings.WarmUpDuration);
+
+		auto bSpawnFloor{false};
+		FParse::Bool(*CommandLine, TEXT("Floor="), bSpawnFloor);
+		Settings.bSpawnFloor = bSpawnFloor;
+
+		auto bQuitWhenFinished{false};
+		FParse::Bool(*CommandLine, TEXT("Quit="), bQuitWhenFinished);
+		Settings.bQuitWhenFinished = bQuitWhenFinished;
+
+		Subsystem->Start(Settings);
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs StartCommand{
+		TEXT("Als.StressTest.Start"),
+		TEXT("Starts the ALS stress test. Arguments: [Scenario=IdleCrowd|SprintCircles|JumpMantle|Ragdoll|StanceThrash] ")
+		TEXT("[Class=Path] [Count=100] [Spacing=400] [Duration=30] [WarmUp=3] [Floor=0] [Quit=0]."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&StartStressTest)
+	};
+
+	FAutoConsoleCommandWithWorld StopCommand{
+		TEXT("Als.StressTest.Stop"),
+		TEXT("Stops the ALS stress test and prints the summary."),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			auto* Subsystem{UAlsStressTestSubsystem::Get(World)};
+			if (IsValid(Subsystem))
+			{
+				Subsystem->Stop();
+			}
+		})
+	};
+#endif
+
+	AStaticMeshActor* SpawnBox(UWorld* World, UStaticMesh* Mesh, const FTransform& Transform)
+	{
+		auto* Box{World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Transform)};
+		if (IsValid(Box))
+		{
+			Box->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+			Box->GetStaticMeshComponent()->SetStaticMesh(Mesh);
+		}
+
+		return Box;
+	}
+
+	FString FormatPercentiles(const TCHAR* Name, TArray<float> Values)
+	{
+		if (Values.IsEmpty())
+		{
+			return FString::Printf(TEXT("%s: no samples."), Name);
+		}
+
+		Values.Sort();
+
+		const auto Percentile{
+			[&Values](const float Fraction)
+			{
+				return Values[FMath::Clamp(FMath::CeilToInt(Fraction * Values.Num()) - 1, 0, Values.Num() - 1)];
+			}
+		};
+
+		auto Sum{0.0};
+
+		for (const auto Value : Values)
+		{
+			Sum += Value;
+		}
+
+		return FString::Printf(TEXT("%s, ms: p50 %.2f, p90 %.2f, p99 %.2f, max %.2f, average %.2f."), Name,
+		                       Percentile(0.5f), Percentile(0.9f), Percentile(0.99f), Values.Last(), Sum / Values.Num());
+	}
+}
+
+UAlsStressTestSubsystem* UAlsStressTestSubsystem::Get(const UWorld* World)
+{
+	return IsValid(World) ? World->GetSubsystem<UAlsStressTestSubsystem>() : nullptr;
+}
+
+void UAlsStressTestSubsystem::Deinitialize()
+{
+	bRunning = false;
+
+	StopCsvCapture();
+
+	DestroyActors();
+
+	Super::Deinitialize();
+}
+
+void UAlsStressTestSubsystem::Tick(const float DeltaTime)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("UAlsStressTestSubsystem::Tick"), STAT_UAlsStressTestSubsystem_Tick, STATGROUP_Als)
+	TRACE_CPUPROFILER_EVENT_SCOPE(__FUNCTION__);
+
+	Super::Tick(DeltaTime);
+
+	if (!bRunning)
+	{
+		return;
+	}
+
+	const auto PreviousTime{Time};
+	Time += DeltaTime;
+
+	for (auto i{0}; i < Agents.Num(); i++)
+	{
+		RefreshAgent(Agents[i], i, PreviousTime);
+	}
+
+	if (Time > Settings.WarmUpDuration)
+	{
+		if (PreviousTime <= Settings.WarmUpDuration)
+		{
+			StartCsvCapture();
+		}
+
+		RecordFrame();
+	}
+
+	if (Time >= Settings.WarmUpDuration + Settings.Duration)
+	{
+		Stop();
+
+		if (Settings.bQuitWhenFinished)
+		{
+			FPlatformMisc::RequestExit(false, TEXT("UAlsStressTestSubsystem::Tick"));
+		}
+	}
+}
+
+TStatId UAlsStressTestSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAlsStressTestSubsystem, STATGROUP_Tickables)
+}
+
+bool UAlsStressTestSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UAlsStressTestSubsystem::Start(const FAlsStressTestSettings& NewSettings)
+{
+	if (bRunning)
+	{
+		UE_LOG(LogAls, Warning, TEXT("The stress test is already running."));
+		return false;
+	}
+
+	if (!IsValid(NewSettings.CharacterClass) || NewSettings.CharactersCount <= 0)
+	{
+		UE_LOG(LogAls, Warning, TEXT("The stress test requires a valid ALS character class and a positive number of characters."));
+		return false;
+	}
+
+	Settings = NewSettings;
+
+	bRunning = true;
+	Time = 0.0f;
+
+	const auto ScenarioName{StaticEnum<EAlsStressTestScenario>()->GetNameStringByValue(static_cast<int64>(Settings.Scenario))};
+
+	ReportName = FString::Printf(TEXT("%s-%s"), *ScenarioName, *FDateTime::Now().ToString());
+
+	FrameTimes.Reset();
+	GameThreadTimes.Reset();
+
+	CategoryCostSums.Reset();
+	CategoryCostSums.SetNumZeroed(AlsCostTracking::CategoriesCount);
+	CostSamplesCount = 0;
+
+	SpawnActors();
+
+	UE_LOG(LogAls, Log, TEXT("Started the %s stress test with %d characters."), *ScenarioName, Agents.Num());
+
+	return true;
+}
+
+void UAlsStressTestSubsystem::Stop()
+{
+	if (!bRunning)
+	{
+		return;
+	}
+
+	bRunning = false;
+
+	PrintSummary();
+	StopCsvCapture();
+	DestroyActors();
+}
+
+void UAlsStressTestSubsystem::SpawnActors()
+{
+	auto* World{GetWorld()};
+
+	// Place the grid in front of the player pawn if there is one, otherwise at the world origin.
+
+	auto Origin{FVector::ZeroVector};
+	auto Rotation{FRotator::ZeroRotator};
+
+	const auto* Player{World->GetFirstPlayerController()};
+	const auto* PlayerPawn{IsValid(Player) ? Player->GetPawn() : nullptr};
+
+	if (IsValid(PlayerPawn))
+	{
+		Origin = PlayerPawn->GetActorLocation() - FVector{0.0f, 0.0f, PlayerPawn->GetDefaultHalfHeight()};
+		Rotation.Yaw = PlayerPawn->GetActorRotation().Yaw;
+	}
+
+	const auto Forward{Rotation.Vector()};
+	const auto Right{FRotationMatrix{Rotation}.GetUnitAxis(EAxis::Y)};
+
+	const auto ColumnsCount{FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Settings.CharactersCount)))};
+	const auto RowsCount{FMath::DivideAndRoundUp(Settings.CharactersCount, ColumnsCount)};
+
+	auto* BoxMesh{
+		Settings.bSpawnFloor || Settings.Scenario == EAlsStressTestScenario::JumpMantle
+			? LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"))
+			: nullptr
+	};
+
+	// The engine cube is 100 units in size and has its pivot in the center.
+
+	static constexpr auto BoxSize{100.0f};
+
+	if (Settings.bSpawnFloor && ALS_ENSURE(IsValid(BoxMesh)))
+	{
+		static constexpr auto FloorThickness{10.0f};
+
+		const auto FloorCenter{Origin + Forward * ((RowsCount + 1) * Settings.Spacing * 0.5f) - FVector{0.0f, 0.0f, FloorThickness * 0.5f}};
+
+		const FVector FloorScale{
+			(RowsCount + 3) * Settings.Spacing / BoxSize,
+			(ColumnsCount + 2) * Settings.Spacing / BoxSize,
+			FloorThickness / BoxSize
+		};
+
+		SpawnedActors.Emplace(AlsStressTest::SpawnBox(World, BoxMesh, FTransform{Rotation, FloorCenter, FloorScale}));
+	}
+
+	const auto CharacterHalfHeight{Settings.CharacterClass.GetDefaultObject()->GetDefaultHalfHeight()};
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	SpawnParameters.bDeferConstruction = true;
+
+	Agents.Reset(Settings.CharactersCount);
+
+	for (auto i{0}; i < Settings.CharactersCount; i++)
+	{
+		const auto Row{i / ColumnsCount};
+		const auto Column{i % ColumnsCount};
+
+		const auto CellLocation{
+			Origin + Forward * ((Row + 1) * Settings.Spacing) + Right * ((Column - (ColumnsCount - 1) * 0.5f) * Settings.Spacing)
+		};
+
+		const FTransform Transform{Rotation, CellLocation + FVector{0.0f, 0.0f, CharacterHalfHeight}};
+
+		auto* Character{World->SpawnActor<AAlsCharacter>(Settings.CharacterClass, Transform, SpawnParameters)};
+		if (!IsValid(Character))
+		{
+			continue;
+		}
+
+		// Use a controller without a behavior tree, so that nothing but the scenario drives the character.
+
+		Character->AIControllerClass = AAIController::StaticClass();
+		Character->AutoPossessAI = EAutoPossessAI::Spawned;
+
+		Character->FinishSpawning(Transform);
+
+		SpawnedActors.Emplace(Character);
+
+		if (IsValid(Character->GetController()))
+		{
+			SpawnedActors.Emplace(Character->GetController());
+		}
+
+		auto& Agent{Agents.Emplace_GetRef()};
+
+		Agent.Character = Character;
+		Agent.Location = Character->GetActorLocation();
+		Agent.Rotation = Rotation;
+		Agent.TimeOffset = FMath::Frac(i * UE_GOLDEN_RATIO);
+
+		switch (Settings.Scenario)
+		{
+			case EAlsStressTestScenario::SprintCircles:
+				Character->SetDesiredGait(AlsGaitTags::Sprinting);
+				break;
+
+			case EAlsStressTestScenario::JumpMantle:
+				Character->SetDesiredGait(AlsGaitTags::Running);
+
+				if (ALS_ENSURE(IsValid(BoxMesh)))
+				{
+					static constexpr auto ObstacleHeight{100.0f};
+
+					const auto ObstacleLocation{
+						CellLocation + Forward * (Settings.Spacing * 0.5f) + FVector{0.0f, 0.0f, ObstacleHeight * 0.5f}
+					};
+					const FVector ObstacleScale{0.5f, Settings.Spacing * 0.8f / BoxSize, ObstacleHeight / BoxSize};
+
+					SpawnedActors.Emplace(AlsStressTest::SpawnBox(World, BoxMesh, FTransform{Rotation, ObstacleLocation, ObstacleScale}));
+				}
+				break;
+
+			default:
+				break;
+		}
+	}
+}
+
+void UAlsStressTestSubsystem::DestroyActors()
+{
+	for (auto* Actor : SpawnedActors)
+	{
+		if (IsValid(Actor))
+		{
+			Actor->Destroy();
+		}
+	}
+
+	SpawnedActors.Reset();
+	Agents.Reset();
+}
+
+void UAlsStressTestSubsystem::RefreshAgent(const FAgent& Agent, const int32 AgentIndex, const float PreviousTime) const
+{
+	auto* Character{Agent.Character.Get()};
+	if (!IsValid(Character))
+	{
+		return;
+	}
+
+	if (Settings.Scenario == EAlsStressTestScenario::SprintCircles)
+	{
+		static constexpr auto TurnSpeed{2.0f};
+
+		const auto Angle{Agent.Rotation.Yaw + FMath::RadiansToDegrees((Time + Agent.TimeOffset) * TurnSpeed)};
+
+		Character->AddMovementInput(FRotator{0.0f, Angle, 0.0f}.Vector());
+	}
+	else if (Settings.Scenario == EAlsStressTestScenario::JumpMantle)
+	{
+		static constexpr auto CycleDuration{4.0f};
+		static constexpr auto JumpTime{0.6f};
+		static constexpr auto GroundedMantlingTime{1.2f};
+
+		if (AlsTestUtility::HasPassed(PreviousTime, Time, CycleDuration, 0.0f) &&
+		    Character->GetLocomotionAction() != AlsLocomotionActionTags::Mantling)
+		{
+			Character->TeleportTo(Agent.Location, Agent.Rotation, false, true);
+		}
+
+		Character->AddMovementInput(Agent.Rotation.Vector());
+
+		if (AlsTestUtility::HasPassed(PreviousTime, Time, CycleDuration, JumpTime))
+		{
+			// Mantling in the air is started by the character itself if it has input towards the obstacle.
+			Character->Jump();
+		}
+		else if (AlsTestUtility::HasPassed(PreviousTime, Time, CycleDuration, GroundedMantlingTime))
+		{
+			Character->StartMantlingGrounded();
+		}
+	}
+	else if (Settings.Scenario == EAlsStressTestScenario::Ragdoll)
+	{
+		static constexpr auto CycleDuration{6.0f};
+		static constexpr auto RagdollingStartTime{1.0f};
+		static constexpr auto RagdollingStopTime{4.0f};
+
+		if (AlsTestUtility::HasPassed(PreviousTime, Time, CycleDuration, RagdollingStartTime))
+		{
+			Character->StartRagdolling();
+		}
+		else if (AlsTestUtility::HasPassed(PreviousTime, Time, CycleDuration, RagdollingStopTime))
+		{
+			Character->StopRagdolling();
+		}
+	}
+	else if (Settings.Scenario == EAlsStressTestScenario::StanceThrash)
+	{
+		static constexpr auto TurnSpeed{0.5f};
+		static constexpr auto StanceChangeInterval{0.5f};
+		static constexpr auto RotationModeChangeInterval{0.7f};
+		static constexpr auto GaitChangeInterval{0.9f};
+
+		const auto Angle{Agent.Rotation.Yaw + FMath::RadiansToDegrees(Time * TurnSpeed)};
+
+		Character->AddMovementInput(FRotator{0.0f, Angle, 0.0f}.Vector());
+
+		if (AlsTestUtility::HasPassed(PreviousTime, Time, StanceChangeInterval, Agent.TimeOffset))
+		{
+			Character->SetDesiredStance(Character->GetDesiredStance() == AlsStanceTags::Standing
+				                            ? AlsStanceTags::Crouching
+				                            : AlsStanceTags::Standing);
+		}
+
+		if (AlsTestUtility::HasPassed(PreviousTime, Time, RotationModeChangeInterval, Agent.TimeOffset))
+		{
+			// Cycle through the velocity direction, view direction and aiming rotation modes.
+
+			if (Character->IsDesiredAiming())
+			{
+				Character->SetDesiredAiming(false);
+				Character->SetDesiredRotationMode(AlsRotationModeTags::VelocityDirection);
+			}
+			else if (Character->GetDesiredRotationMode() == AlsRotationModeTags::VelocityDirection)
+			{
+				Character->SetDesiredRotationMode(AlsRotationModeTags::ViewDirection);
+			}
+			else
+			{
+				Character->SetDesiredAiming(true);
+			}
+		}
+
+		if (AlsTestUtility::HasPassed(PreviousTime, Time, GaitChangeInterval, Agent.TimeOffset + AgentIndex % 3 * 0.1f))
+		{
+			const auto& DesiredGait{Character->GetDesiredGait()};
+
+			Character->SetDesiredGait(DesiredGait == AlsGaitTags::Walking
+				                          ? AlsGaitTags::Running
+				                          : DesiredGait == AlsGaitTags::Running
+				                          ? AlsGaitTags::Sprinting
+				                          : AlsGaitTags::Walking);
+		}
+	}
+}
+
+void UAlsStressTestSubsystem::StartCsvCapture()
+{
+#if CSV_PROFILER
+	// Capture a CSV profile for the duration of the measurement, so that the ALS stats that are always recorded, such as
+	// the number of characters per locomotion action or the number of network corrections, are included in the results.
+	// Leave the capture alone if it was already started by someone else, for example, with the csvprofile console command.
+
+	auto* CsvProfiler{FCsvProfiler::Get()};
+	if (CsvProfiler->IsCapturing())
+	{
+		return;
+	}
+
+	CsvProfiler->BeginCapture(-1, FPaths::ProfilingDir() / TEXT("AlsStressTest"), ReportName + TEXT(".csv"));
+	bCsvCaptureStarted = true;
+#endif
+}
+
+void UAlsStressTestSubsystem::StopCsvCapture()
+{
+#if CSV_PROFILER
+	if (bCsvCaptureStarted)
+	{
+		bCsvCaptureStarted = false;
+		FCsvProfiler::Get()->EndCapture();
+	}
+#endif
+}
+
+void UAlsStressTestSubsystem::RecordFrame()
+{
+	FrameTimes.Emplace(static_cast<float>(FApp::GetDeltaTime() * 1000.0));
+	GameThreadTimes.Emplace(static_cast<float>(FPlatformTime::ToMilliseconds(GGameThreadTime)));
+
+	if (!AlsCostTracking::IsEnabled())
+	{
+		return;
+	}
+
+	// Sum the costs of all characters to get the total ALS cost of the frame.
+
+	for (const auto& Agent : Agents)
+	{
+		const auto* Character{Agent.Character.Get()};
+		if (!IsValid(Character))
+		{
+			continue;
+		}
+
+		for (auto i{0}; i < AlsCostTracking::CategoriesCount; i++)
+		{
+			CategoryCostSums[i] += Character->GetCosts().GetAverageMilliseconds(static_cast<EAlsCostCategory>(i));
+		}
+	}
+
+	CostSamplesCount += 1;
+}
+
+void UAlsStressTestSubsystem::PrintSummary() const
+{
+	if (FrameTimes.IsEmpty())
+	{
+		UE_LOG(LogAls, Log, TEXT("The stress test was stopped before any frames were recorded."));
+		return;
+	}
+
+	const auto ScenarioName{StaticEnum<EAlsStressTestScenario>()->GetNameStringByValue(static_cast<int64>(Settings.Scenario))};
+
+	TArray<FString> Lines;
+
+	Lines.Emplace(FString::Printf(TEXT("ALS stress test summary: scenario %s, %d characters, %d frames."),
+	                              *ScenarioName, Agents.Num(), FrameTimes.Num()));
+
+	Lines.Emplace(AlsStressTest::FormatPercentiles(TEXT("Frame time"), FrameTimes));
+	Lines.Emplace(AlsStressTest::FormatPercentiles(TEXT("Game thread time"), GameThreadTimes));
+
+	if (CostSamplesCount > 0)
+	{
+		TStringBuilder<512> LineBuilder;
+		LineBuilder << TEXTVIEW("Average ALS cost per frame for all characters, ms:");
+
+		for (auto i{0}; i < AlsCostTracking::CategoriesCount; i++)
+		{
+			LineBuilder.Appendf(TEXT("%s %s %.3f"), i > 0 ? TEXT(",") : TEXT(""),
+			                    AlsCostTracking::GetCategoryName(static_cast<EAlsCostCategory>(i)),
+			                    CategoryCostSums[i] / CostSamplesCount);
+		}
+
+		LineBuilder << TEXTVIEW(".");
+
+		Lines.Emplace(LineBuilder.ToString());
+	}
+	else
+	{
+		Lines.Emplace(TEXT("Set Als.Cost.Enabled to 1 before starting the stress test to get the ALS cost per category."));
+	}
+
+	if (bCsvCaptureStarted)
+	{
+		Lines.Emplace(FString::Printf(TEXT("The CSV profile of the measurement is saved to %s."),
+		                              *(FPaths::ProfilingDir() / TEXT("AlsStressTest") / ReportName + TEXT(".csv"))));
+	}
+
+	for (const auto& Line : Lines)
+	{
+		UE_LOG(LogAls, Display, TEXT("%s"), *Line);
+	}
+
+	const auto FilePath{FPaths::ProfilingDir() / TEXT("AlsStressTest") / ReportName + TEXT(".txt")};
+
+	if (FFileHelper::SaveStringArrayToFile(Lines, *FilePath))
+	{
+		UE_LOG(LogAls, Display, TEXT("The stress test summary is saved to %s."), *FilePath);
+	}
+}
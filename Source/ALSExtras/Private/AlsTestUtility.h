@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Math/UnrealMathUtility.h"
+
+// Helpers shared by the scripted test subsystems.
+namespace AlsTestUtility
+{
+	// Returns true if a moment that repeats with the given period, shifted by the offset, was passed during the frame.
+	inline bool HasPassed(const float PreviousTime, const float Time, const float Period, const float Offset)
+	{
+		return FMath::FloorToInt((Time - Offset) / Period) != FMath::FloorToInt((PreviousTime - Offset) / Period);
+	}
+}
@@ -8,10 +8,26 @@ class ALSEXTRAS_API AAlsAIController : public AAIController
 {
 	GENERATED_BODY()
 
+public:
+	// Number of groups over which the control rotation updates of controllers are staggered.
+	static constexpr auto ControlRotationUpdateGroupsCount{8};
+
 protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
 	TObjectPtr<UBehaviorTree> BehaviorTree;
 
+	// If greater than 0, the focal point and control rotation are updated at this interval instead of every frame. Updates
+	// of different controllers are staggered across frames. The view rotation of the character is still smoothed on clients,
+	// and the character itself rotates towards the view rotation smoothly, so the reduced update rate is hardly noticeable.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", Meta = (ClampMin = 0, ClampMax = 1, ForceUnits = "s"))
+	float ControlRotationUpdateInterval{0.0f};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient, Meta = (ForceUnits = "s"))
+	float ControlRotationUpdateTimeRemaining{0.0f};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient, Meta = (ForceUnits = "s"))
+	float ControlRotationUpdateDeltaTime{0.0f};
+
 public:
 	AAlsAIController();
 
@@ -19,5 +35,25 @@ protected:
 	virtual void OnPossess(APawn* NewPawn) override;
 
 public:
+	virtual void UpdateControlRotation(float DeltaTime, bool bUpdatePawn = true) override;
+
+	virtual void SetFocalPoint(FVector NewFocus, EAIFocusPriority::Type InPriority = EAIFocusPriority::Gameplay) override;
+
+	virtual void SetFocus(AActor* NewFocus, EAIFocusPriority::Type InPriority = EAIFocusPriority::Gameplay) override;
+
+	virtual void ClearFocus(EAIFocusPriority::Type InPriority) override;
+
 	virtual FVector GetFocalPointOnActor(const AActor* Actor) const override;
+
+	// Makes the next control rotation update happen in the current frame, regardless of the update interval.
+	UFUNCTION(BlueprintCallable, Category = "ALS|Als AI Controller")
+	void ForceControlRotationUpdate();
+
+private:
+	void ForceControlRotationUpdateIfFocusChanged(const AActor* PreviousFocusActor, const FVector& PreviousFocalPoint);
 };
+
+inline void AAlsAIController::ForceControlRotationUpdate()
+{
+	ControlRotationUpdateTimeRemaining = 0.0f;
+}
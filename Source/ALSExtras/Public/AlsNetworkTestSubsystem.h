@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "AlsNetworkTestSubsystem.generated.h"
+
+struct ALSEXTRAS_API FAlsNetworkTestSettings
+{
+	// Duration of the measurement.
+	float Duration{60.0f};
+
+	// Percentage of outgoing packets dropped by the net driver of each world.
+	int32 PacketLossPercentage{5};
+
+	// Delay of outgoing packets of the net driver of each world.
+	int32 PacketLagMilliseconds{100};
+
+	int32 PacketLagVarianceMilliseconds{20};
+
+	// If true, the quit command is executed once the summary is printed, which ends the play in editor session or exits
+	// the application, so the test can be run unattended.
+	uint8 bQuitWhenFinished : 1 {false};
+};
+
+// Measures how ALS client prediction copes with adverse network conditions. Applies packet loss and lag emulation to the
+// net driver of the world, drives the characters of local players through scripted movement with gait, stance and rotation
+// mode changes, jumps and mantling, then prints the number and distance of network corrections and the bandwidth used. The
+// Als.NetworkTest.Start console command starts the test in all worlds of the process, so when playing in editor in a single
+// process, the server and all clients are measured at once. Mantling only happens if the level has suitable geometry.
+UCLASS()
+class ALSEXTRAS_API UAlsNetworkTestSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	struct FPacketSimulation
+	{
+		int32 PacketLossPercentage{0};
+
+		int32 PacketLagMilliseconds{0};
+
+		int32 PacketLagVarianceMilliseconds{0};
+	};
+
+	FAlsNetworkTestSettings Settings;
+
+	uint8 bRunning : 1 {false};
+
+	float Time{0.0f};
+
+	FPacketSimulation PreviousPacketSimulation;
+
+	int64 InitialInBytes{0};
+
+	int64 InitialOutBytes{0};
+
+public:
+	static UAlsNetworkTestSubsystem* Get(const UWorld* World);
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+public:
+	bool IsRunning() const;
+
+	bool Start(const FAlsNetworkTestSettings& NewSettings);
+
+	// Stops the test, prints the summary and restores the previous packet simulation settings.
+	void Stop();
+
+private:
+	FPacketSimulation SetPacketSimulation(const FPacketSimulation& NewPacketSimulation) const;
+
+	void GetTransferredBytes(int64& InBytes, int64& OutBytes) const;
+
+	void ResetCorrectionStatistics() const;
+
+	void RefreshLocalCharacters(float PreviousTime) const;
+
+	void PrintSummary() const;
+};
+
+inline bool UAlsNetworkTestSubsystem::IsRunning() const
+{
+	return bRunning;
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Templates/SubclassOf.h"
+#include "AlsStressTestSubsystem.generated.h"
+
+class AAlsCharacter;
+
+UENUM()
+enum class EAlsStressTestScenario : uint8
+{
+	// Characters stand still.
+	IdleCrowd,
+	// Characters sprint in circles, running into each other.
+	SprintCircles,
+	// Characters run towards an obstacle in front of them, jump and mantle onto it, then are teleported back.
+	JumpMantle,
+	// Characters start ragdolling all at once, then get up all at once.
+	Ragdoll,
+	// Characters walk in circles while constantly changing their stance, gait and rotation mode.
+	StanceThrash
+};
+
+struct ALSEXTRAS_API FAlsStressTestSettings
+{
+	EAlsStressTestScenario Scenario{EAlsStressTestScenario::IdleCrowd};
+
+	TSubclassOf<AAlsCharacter> CharacterClass;
+
+	int32 CharactersCount{100};
+
+	float Spacing{400.0f};
+
+	// Duration of the measurement, not including the warm up.
+	float Duration{30.0f};
+
+	// Time after spawning the characters during which frame times are not recorded.
+	float WarmUpDuration{3.0f};
+
+	// If true, a floor is spawned under the characters, so the test can be run in an empty level.
+	uint8 bSpawnFloor : 1 {false};
+
+	// If true, the application exits once the summary is printed, so the test can be run unattended from the command line.
+	uint8 bQuitWhenFinished : 1 {false};
+};
+
+// Spawns a grid of AI controlled ALS characters in the world and drives them through a scripted scenario, then prints
+// the frame time percentiles and, if the Als.Cost.Enabled console variable is set, the average ALS cost per category. The
+// summary is also saved to the profiling directory, along with a CSV profile of the measurement that contains the ALS
+// stats, so the results of different builds can be compared. Started with the Als.StressTest.Start console command,
+// which can be passed with -ExecCmds to run the test without user interaction.
+UCLASS()
+class ALSEXTRAS_API UAlsStressTestSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	struct FAgent
+	{
+		TWeakObjectPtr<AAlsCharacter> Character;
+
+		FVector Location{ForceInit};
+
+		FRotator Rotation{ForceInit};
+
+		// Used to desynchronize the agents in scenarios where they shouldn't act all at once.
+		float TimeOffset{0.0f};
+	};
+
+	FAlsStressTestSettings Settings;
+
+	uint8 bRunning : 1 {false};
+
+	// Whether the CSV profile capture was started by the stress test, and therefore should be stopped by it.
+	uint8 bCsvCaptureStarted : 1 {false};
+
+	float Time{0.0f};
+
+	// Scenario name and start time, used as the file name of the summary and the CSV profile.
+	FString ReportName;
+
+	TArray<FAgent> Agents;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AActor>> SpawnedActors;
+
+	TArray<float> FrameTimes;
+
+	TArray<float> GameThreadTimes;
+
+	TArray<double> CategoryCostSums;
+
+	int32 CostSamplesCount{0};
+
+public:
+	static UAlsStressTestSubsystem* Get(const UWorld* World);
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+public:
+	bool IsRunning() const;
+
+	bool Start(const FAlsStressTestSettings& NewSettings);
+
+	// Stops the test, prints the summary if anything was recorded and destroys the spawned actors.
+	void Stop();
+
+private:
+	void SpawnActors();
+
+	void DestroyActors();
+
+	void RefreshAgent(const FAgent& Agent, int32 AgentIndex, float PreviousTime) const;
+
+	void StartCsvCapture();
+
+	void StopCsvCapture();
+
+	void RecordFrame();
+
+	void PrintSummary() const;
+};
+
+inline bool UAlsStressTestSubsystem::IsRunning() const
+{
+	return bRunning;
+}